@@ -0,0 +1,75 @@
+#include "raym3/raym3.h"
+#include "raym3/rendering/DrawCommandBuffer.h"
+#include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/SdfRenderer.h"
+#include <cstdio>
+#include <raylib.h>
+
+// Draws a grid of elevated, outlined cards and alternates between the
+// tessellated and SDF shape paths, printing the average CPU time spent
+// submitting and flushing each frame's raym3 drawing.
+int main() {
+  InitWindow(1280, 800, "raym3 SDF Benchmark");
+  SetTargetFPS(0);
+
+  raym3::Initialize();
+  raym3::SetDrawBatching(true);
+
+  const int columns = 24;
+  const int rows = 16;
+  const int framesPerRun = 300;
+  const int runs = 4;
+
+  bool sdf = false;
+  double totalTime = 0.0;
+  int frame = 0;
+  int run = 0;
+
+  if (!raym3::SdfRenderer::IsSupported()) {
+    printf("SDF shapes unsupported on this GL context, only tessellation "
+           "will be measured\n");
+  }
+
+  while (!WindowShouldClose() && run < runs) {
+    BeginDrawing();
+    ClearBackground(raym3::Theme::GetColorScheme().surface);
+
+    double start = GetTime();
+    raym3::BeginFrame();
+    float cellW = GetScreenWidth() / (float)columns;
+    float cellH = GetScreenHeight() / (float)rows;
+    for (int y = 0; y < rows; y++) {
+      for (int x = 0; x < columns; x++) {
+        Rectangle card = {x * cellW + 6.0f, y * cellH + 6.0f, cellW - 12.0f,
+                          cellH - 12.0f};
+        int elevation = 1 + (x + y) % 5;
+        raym3::Renderer::DrawElevatedRectangle(
+            card, 12.0f, elevation, raym3::Theme::GetColorScheme().surface);
+        raym3::Renderer::DrawRoundedRectangleEx(
+            card, 12.0f, raym3::Theme::GetColorScheme().outline, 1.0f);
+      }
+    }
+    raym3::EndFrame();
+    totalTime += GetTime() - start;
+
+    DrawText(sdf ? "SDF" : "Tessellated", 10, 10, 20, RED);
+    EndDrawing();
+
+    if (++frame == framesPerRun) {
+      const raym3::DrawBatchStats &stats =
+          raym3::DrawCommandBuffer::GetFrameStats();
+      printf("%-12s %.3f ms/frame (%d commands, %d batches)\n",
+             sdf ? "SDF" : "Tessellated", totalTime * 1000.0 / framesPerRun,
+             stats.commands, stats.batches);
+      sdf = !sdf;
+      raym3::SetSdfShapes(sdf);
+      totalTime = 0.0;
+      frame = 0;
+      run++;
+    }
+  }
+
+  raym3::Shutdown();
+  CloseWindow();
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include "raym3/raym3.h"
+#include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/SoftwareBackend.h"
+#include "raym3/rendering/TextMeasureCache.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Measures a screen of 1,000 static labels per frame, the way widgets do
+// every frame, with the measurement cache off, on, and on with precomputed
+// hashes. Runs headlessly on the software backend.
+static double RunFrames(const std::vector<std::string> &labels,
+                        const std::vector<uint64_t> *hashes, int frames,
+                        float *checksum) {
+  auto start = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < frames; frame++) {
+    raym3::BeginFrame();
+    for (size_t i = 0; i < labels.size(); i++) {
+      float size = (i % 3 == 0) ? 14.0f : 16.0f;
+      raym3::FontWeight weight = (i % 4 == 0) ? raym3::FontWeight::Bold
+                                              : raym3::FontWeight::Regular;
+      uint64_t hash = hashes ? (*hashes)[i] : 0;
+      *checksum +=
+          raym3::Renderer::MeasureText(labels[i].c_str(), size, weight, hash)
+              .x;
+    }
+    raym3::EndFrame();
+  }
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - start)
+             .count() /
+         frames;
+}
+
+int main() {
+  raym3::SoftwareBackend backend(1280, 800);
+  raym3::SetRenderBackend(&backend);
+  raym3::Initialize();
+
+  const int labelCount = 1000;
+  const int frames = 200;
+  std::vector<std::string> labels;
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < labelCount; i++) {
+    labels.push_back("Settings item " + std::to_string(i) + " - Description");
+    hashes.push_back(raym3::TextMeasureCache::Hash(labels.back().c_str()));
+  }
+
+  float checksum = 0.0f;
+  raym3::TextMeasureCache::SetEnabled(false);
+  double uncached = RunFrames(labels, nullptr, frames, &checksum);
+
+  raym3::TextMeasureCache::SetEnabled(true);
+  raym3::TextMeasureCache::ResetStats();
+  double cached = RunFrames(labels, nullptr, frames, &checksum);
+  double precomputed = RunFrames(labels, &hashes, frames, &checksum);
+
+  const raym3::TextMeasureCacheStats &stats =
+      raym3::TextMeasureCache::GetStats();
+  printf("%d labels, %d frames\n", labelCount, frames);
+  printf("  uncached:            %8.1f us/frame\n", uncached);
+  printf("  cached:              %8.1f us/frame (%.1fx)\n", cached,
+         uncached / cached);
+  printf("  precomputed hashes:  %8.1f us/frame (%.1fx)\n", precomputed,
+         uncached / precomputed);
+  printf("  hit rate %.2f%% (%d hits, %d misses), checksum %.0f\n",
+         100.0 * stats.hits / (stats.hits + stats.misses), stats.hits,
+         stats.misses, checksum);
+
+  raym3::Shutdown();
+  raym3::SetRenderBackend(nullptr);
+  return 0;
+}
@@ -12,6 +12,13 @@ public:
                      FontWeight weight = FontWeight::Regular,
                      TextAlignment alignment = TextAlignment::Left,
                      int selectionStart = -1, int selectionEnd = -1);
+  // Word-wrapped to bounds.width and drawn from the top of bounds. maxLines
+  // 0 shows every line bounds.height fits.
+  static void RenderWrapped(const char *text, Rectangle bounds, float fontSize,
+                            Color color = BLANK,
+                            FontWeight weight = FontWeight::Regular,
+                            TextAlignment alignment = TextAlignment::Left,
+                            int maxLines = 0);
 };
 
 } // namespace raym3
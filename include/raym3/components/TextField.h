@@ -15,7 +15,8 @@ public:
 
 private:
   static void UpdateCursor(char *buffer, int bufferSize, float &lastBlinkTime);
-  static void DrawCursor(Rectangle bounds, const char *text, int position,
+  // cursorOffset is the width of the text before the caret.
+  static void DrawCursor(Rectangle bounds, float cursorOffset,
                          float scrollOffset, float lastBlinkTime,
                          float textStartX, Color bgColor);
 };
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace raym3 {
+
+// One rasterized glyph, as stored in or read from a cache file.
+struct CachedGlyph {
+  int codepoint;
+  int offsetX;
+  int offsetY;
+  int advanceX;
+  int width;  // Rect size; spaces have one but no pixels
+  int height;
+  const unsigned char *pixels; // width * height coverage, or nullptr
+};
+
+struct FontAtlasCacheStats {
+  int filesLoaded = 0;
+  int filesRejected = 0; // Stale version, other face data, or corrupt
+  int glyphsLoaded = 0;
+  int filesWritten = 0;
+};
+
+// Glyph bitmaps and metrics kept on disk across runs, so a warm start packs
+// them into the GlyphAtlas straight from a memory-mapped file instead of
+// rendering them from the TTF data again.
+//
+// There is one file per face and pixel size, named after a hash of the
+// face's TTF data, and it holds every codepoint rasterized at that size so
+// far. A header carries a format version, the raylib version (whose
+// stb_truetype renders the bitmaps), the face hash, the size and a checksum
+// of the contents; a file that disagrees with any of them is ignored and
+// replaced on the next Save(). Files are written to a temporary name and
+// renamed, so a crash never leaves a partial file behind. They use the
+// machine's byte order and are meant as a local cache, not for shipping.
+//
+// Off until SetDirectory() is given a path. FontManager loads a font's file
+// the first time it needs glyphs and writes new glyphs back at Shutdown().
+class FontAtlasCache {
+public:
+  // Empty disables the cache. Created on the first Save() if needed.
+  static void SetDirectory(const std::string &directory);
+  static const std::string &GetDirectory() { return directory_; }
+  static bool IsEnabled() { return !directory_.empty(); }
+
+  // 64-bit FNV-1a, used for face data and file checksums.
+  static uint64_t Hash(const void *data, size_t size);
+
+  // Calls use with the glyphs in the file for (faceHash, size). Their pixels
+  // point into the mapping and are only valid during the call. Returns false
+  // if there is no valid file.
+  static bool
+  Load(uint64_t faceHash, int size,
+       const std::function<void(const std::vector<CachedGlyph> &)> &use);
+  // Replaces the file for (faceHash, size) with glyphs.
+  static bool Save(uint64_t faceHash, int size,
+                   const std::vector<CachedGlyph> &glyphs);
+
+  static const FontAtlasCacheStats &GetStats() { return stats_; }
+  static void ResetStats() { stats_ = {}; }
+
+private:
+  static std::string FilePath(uint64_t faceHash, int size);
+
+  static std::string directory_;
+  static FontAtlasCacheStats stats_;
+};
+
+} // namespace raym3
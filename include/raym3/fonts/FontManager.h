@@ -1,9 +1,17 @@
 #pragma once
 
 #include "raym3/types.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <raylib.h>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace raym3 {
 
@@ -25,10 +33,43 @@ struct FontKeyHash {
   }
 };
 
+// Fonts are raylib Font structs whose glyph rects point into the shared
+// GlyphAtlas. A font starts with metrics and bitmaps for no glyphs;
+// EnsureGlyphs() rasterizes the ones a string needs from the TTF data, which
+// is loaded once per face. Printable ASCII has fixed slots; any other
+// codepoint gets a slot appended the first time it is seen, taken from the
+// first face in the fallback chain that has it, or drawn as '?' if none does.
+//
+// Renderer calls EnsureGlyphs() before measuring or drawing. Code that draws
+// a font with raylib directly must call it first and should re-fetch the
+// font each frame: the atlas texture changes as it grows, and a font's glyph
+// arrays are reallocated as codepoints are added (the old ones stay valid
+// until the end of the frame).
+//
+// With RAYM3_ASYNC_FONTS, glyphs missing from a font are rendered from the
+// TTF data on a small pool of worker threads; only packing them into the
+// atlas and the upload happen on the main thread, at the next BeginFrame().
+// Until then EnsureGlyphs() hands back the loaded font nearest in size (same
+// face first) that already has the text's glyphs, which Renderer scales to
+// the requested size. Text no loaded font can show is rasterized immediately.
+//
+// With a FontAtlasCache directory set, a font's glyphs from earlier runs are
+// packed straight from the cache file the first time the font needs glyphs,
+// and glyphs rasterized since are written back at Shutdown(). Glyphs taken
+// from fallback faces are not cached, as they depend on the fallback chain.
+//
+// In SDF mode each face is instead baked once, at a fixed size, into its own
+// distance-field atlas that Renderer draws at any size with a threshold
+// shader (or a CPU path in SoftwareBackend). Backends that cannot draw SDF
+// text keep getting bitmap fonts. SDF fonts cover printable ASCII only.
 class FontManager {
 public:
   static void Initialize();
   static void Shutdown();
+  // Adds glyphs finished by the worker thread to their fonts.
+  static void BeginFrame();
+  // Frees glyph arrays replaced during the frame.
+  static void EndFrame();
 
   static Font LoadFont(FontWeight weight = FontWeight::Regular,
                        FontStyle style = FontStyle::Normal, int size = 16);
@@ -36,13 +77,169 @@ public:
 
   static void UnloadFont(Font font);
 
-  static Font GetDefaultFont() { return defaultFont_; }
+  static Font GetDefaultFont();
+
+  // Rasterizes the glyphs of text that font is missing into the atlas and
+  // refreshes font (texture and glyph arrays). Fonts FontManager did not
+  // create are untouched.
+  static void EnsureGlyphs(Font &font, const char *text);
+
+  // raylib's GetGlyphIndex() scans every glyph; this is a direct index for
+  // ASCII and a hash lookup otherwise. For FontManager fonts the result is
+  // valid for font as refreshed by EnsureGlyphs().
+  static int GetGlyphIndex(const Font &font, int codepoint);
+
+  // Stable identity for caches keyed by font. Unlike the glyph pointer it
+  // survives glyph array growth and is never reused.
+  static uint64_t GetFontId(const Font &font);
+
+  // Faces searched, in order, for codepoints the font's own face lacks
+  // (e.g. a CJK or emoji font). Paths resolve like LoadCustomFont(). Glyphs
+  // already rasterized are not revisited.
+  static bool AddFallbackFont(const std::string &path);
+  static void ClearFallbackFonts() { fallbackFaces_.clear(); }
+
+  // Queues printable ASCII of each size for rasterization (in the
+  // background when async), so the first frame using them does not stall.
+  // Returns how many sizes were queued on the workers; the rest were loaded
+  // already or rasterized now.
+  static int Prewarm(FontWeight weight, const std::vector<float> &sizes);
+  // Whether missing glyphs go to the worker thread. On by default when
+  // built with RAYM3_ASYNC_FONTS; otherwise always off.
+  static void SetAsyncGlyphs(bool enabled);
+  static bool IsAsyncGlyphsEnabled();
+  // Glyph batches queued or being rasterized.
+  static int GetPendingGlyphJobs();
+  // Of those, the ones the workers have not finished yet; the others are
+  // added at the next BeginFrame().
+  static int GetRasterizingGlyphJobs();
+
+  // Writes glyphs rasterized since their font's FontAtlasCache file was
+  // read. Shutdown() calls it; apps that may exit without shutting down can
+  // call it once their screens are up.
+  static void SaveGlyphCache();
+
+  // Fonts loaded afterwards come from the distance-field atlases. Fonts
+  // already handed out keep working.
+  static void SetSdfEnabled(bool enabled) { sdfEnabled_ = enabled; }
+  static bool IsSdfEnabled() { return sdfEnabled_; }
+  // Whether Renderer should draw font as a distance field.
+  static bool IsSdfFont(const Font &font);
 
 private:
-  static Font LoadRobotoFont(FontWeight weight, FontStyle style, int size);
-  static std::unordered_map<FontKey, Font, FontKeyHash> fontCache_;
-  static Font defaultFont_;
+  struct FontFace {
+    const unsigned char *data;
+    int dataSize;
+    std::vector<unsigned char> owned; // File contents for custom fonts
+    mutable uint64_t hash = 0;        // Of the data; see FaceHash()
+  };
+
+  struct FontEntry {
+    uint64_t id;
+    const FontFace *face;
+    Font font;             // glyphs/recs owned by the entry
+    int capacity;          // Allocated length of the glyph arrays
+    uint32_t generation;   // GlyphAtlas generation the recs belong to
+    std::vector<bool> ready; // Per glyph: metrics and bitmap present
+    // Slots of non-ASCII codepoints. Ones no face has map to '?'.
+    std::unordered_map<int, int> extraIndex;
+    std::unordered_set<int> queued; // Codepoints sent to the worker
+    // Codepoints taken from a fallback face, which the disk cache skips.
+    std::unordered_set<int> fallbackGlyphs;
+    // Glyph slots the atlas had no room for; drawn blank until the next
+    // atlas clear, rather than rasterized again on every draw.
+    std::unordered_set<int> unpacked;
+    uint64_t usedFrame; // Last frame EnsureGlyphs() handed the font out
+    bool diskChecked; // FontAtlasCache file read since the last invalidation
+    bool diskDirty;   // Has glyphs its FontAtlasCache file lacks
+  };
+
+  // Glyphs rendered from the TTF data, before they are packed. Owns the
+  // glyph images.
+  struct GlyphBatch {
+    uint64_t entryId;
+    std::vector<int> codepoints;
+    std::vector<GlyphInfo> glyphs;
+    std::vector<bool> found; // False where no face in the chain has it
+    std::vector<bool> fallback; // Came from a fallback face
+    bool fromDisk; // Images point into a FontAtlasCache file; not owned
+  };
+
+  struct GlyphJob {
+    uint64_t entryId;
+    std::vector<const FontFace *> chain; // Entry face, then fallbacks
+    int size;
+    std::vector<int> codepoints;
+  };
+
+  struct RetiredGlyphs {
+    GlyphInfo *glyphs;
+    Rectangle *recs;
+  };
+
+  static FontEntry *CreateEntry(const FontFace *face, int size);
+  static void DestroyEntry(FontEntry *entry);
+  static FontEntry *FindEntry(const GlyphInfo *glyphs);
+  static int AddGlyphSlot(FontEntry &entry, int codepoint);
+  // Returns whether a bitmap was packed into the atlas. mayReset is passed
+  // to GlyphAtlas::Add().
+  static bool StoreGlyph(FontEntry &entry, int index, GlyphInfo &glyph,
+                         bool mayReset);
+  // Whether a font other than entry has drawn from the atlas this frame.
+  static bool AtlasInUse(const FontEntry &entry);
+  static std::vector<const FontFace *> FaceChain(const FontEntry &entry);
+  // Thread-safe: reads only the (immutable) faces.
+  static GlyphBatch LoadGlyphs(const std::vector<const FontFace *> &chain,
+                               int size, std::vector<int> codepoints);
+  static void ApplyGlyphs(FontEntry &entry, GlyphBatch &batch);
+  static void FreeGlyphBatch(GlyphBatch &batch);
+  static void RasterizeGlyphs(FontEntry &entry, std::vector<int> codepoints);
+  static void InvalidateGlyphs(FontEntry &entry);
+  static uint64_t FaceHash(const FontFace *face);
+  static void LoadCachedGlyphs(FontEntry &entry);
+  static void SaveCachedGlyphs(FontEntry &entry);
+  // Codepoints of text entry has no glyph for, sorted and unique.
+  static void MissingGlyphs(const FontEntry &entry, const char *text,
+                            std::vector<int> *missing);
+  static FontEntry *FindSubstitute(const FontEntry &entry, const char *text);
+  static FontEntry *GetEntry(FontWeight weight, FontStyle style, int size);
+  // Returns whether a job was queued; without RAYM3_ASYNC_FONTS the glyphs
+  // are rasterized now.
+  static bool QueueGlyphs(FontEntry &entry, const std::vector<int> &codepoints);
+  static void WorkerLoop();
+  static void StopWorkers();
+  static const FontFace *LoadFace(const std::string &path);
+  static bool UseSdf();
+  static Font LoadSdfFont(const FontFace *face);
+
+  static FontFace regularFace_;
+  static FontFace boldFace_;
+  static std::unordered_map<std::string, std::unique_ptr<FontFace>>
+      customFaces_;
+  static std::vector<const FontFace *> fallbackFaces_;
+  static std::unordered_map<FontKey, FontEntry *, FontKeyHash> fontCache_;
+  // Every live entry, keyed by its current glyph array.
+  static std::unordered_map<const GlyphInfo *, std::unique_ptr<FontEntry>>
+      entries_;
+  // Glyph arrays replaced this frame, still resolving to their entry.
+  static std::unordered_map<const GlyphInfo *, FontEntry *> aliases_;
+  static std::vector<RetiredGlyphs> retired_;
+  static uint64_t nextFontId_;
+  static uint64_t frameCount_;
+  static FontEntry *defaultEntry_;
+  // One baked distance-field font per face, shared by every size.
+  static std::unordered_map<const FontFace *, Font> sdfFonts_;
+  static bool sdfEnabled_;
   static bool initialized_;
+
+  static bool asyncGlyphs_;
+  static std::vector<std::thread> workers_;
+  static std::mutex jobMutex_; // Guards jobs_, finished_, stopWorkers_
+  static std::condition_variable jobReady_;
+  static std::deque<GlyphJob> jobs_;
+  static std::vector<GlyphBatch> finished_;
+  static int jobsInFlight_;
+  static bool stopWorkers_;
 };
 
 } // namespace raym3
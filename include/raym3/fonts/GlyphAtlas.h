@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <raylib.h>
+#include <vector>
+
+namespace raym3 {
+
+struct GlyphAtlasStats {
+  int width = 0;
+  int height = 0;
+  int glyphs = 0;      // Bitmaps packed since the last reset
+  int uploads = 0;     // Texture region updates
+  int grows = 0;       // Height doublings
+  int resets = 0;      // Clears after filling up at the maximum size
+  int rejected = 0;    // Bitmaps too big, or refused by a full atlas
+  float usage = 0.0f;  // Packed area / atlas area
+};
+
+// One texture shared by every font size and weight, so text in different
+// styles batches together. Coverage bitmaps are packed with a skyline packer
+// into a GRAY_ALPHA image mirrored on the CPU; rows changed since the last
+// upload are sent when the texture is next requested.
+//
+// The atlas grows by doubling its height, which keeps existing rects valid
+// but recreates the texture. When it is full at the maximum size it is
+// cleared and its generation bumps, so fonts rasterize their glyphs again.
+// Callers refuse the clear while other fonts' glyphs are in use.
+// Replaced textures are unloaded at EndFrame(), after recorded draws that
+// reference them have been flushed.
+class GlyphAtlas {
+public:
+  // Packs a width x height coverage bitmap (stride bytes per row) with
+  // `padding` transparent texels on each side. rect receives the bitmap's
+  // position without the padding. May grow the atlas, and when it is full
+  // reset it if mayReset; returns false if the bitmap does not fit.
+  static bool Add(const unsigned char *coverage, int width, int height,
+                  int stride, int padding, bool mayReset, Rectangle *rect);
+
+  // Copies the coverage of a rect returned by Add() in the current
+  // generation into coverage, width * height bytes.
+  static void Read(Rectangle rect, unsigned char *coverage);
+
+  // Current texture with pending glyphs uploaded. id 0 if nothing has been
+  // packed yet or the backend could not create it.
+  static Texture2D GetTexture();
+
+  // Rects from an older generation are invalid.
+  static uint32_t GetGeneration() { return generation_; }
+
+  static void EndFrame();
+  static void Shutdown();
+
+  static const GlyphAtlasStats &GetStats() { return stats_; }
+
+private:
+  struct SkylineNode {
+    int x;
+    int y;
+    int width;
+  };
+
+  static int width_;
+  static int height_;
+  static std::vector<unsigned char> pixels_; // GRAY_ALPHA, width_ * height_
+  static std::vector<SkylineNode> skyline_;
+  static Texture2D texture_;
+  static std::vector<Texture2D> retired_;
+  static int dirtyTop_;    // First row changed since the last upload
+  static int dirtyBottom_; // One past the last changed row
+  static int packedArea_;
+  static uint32_t generation_;
+  static GlyphAtlasStats stats_;
+
+  static int Fit(size_t index, int width, int height);
+  static bool Pack(int width, int height, int *x, int *y);
+  static bool Grow();
+  static void Reset();
+  static void RetireTexture();
+};
+
+} // namespace raym3
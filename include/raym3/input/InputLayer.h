@@ -59,6 +59,9 @@ public:
   // Input consumption
   static void ConsumeInput();
 
+  // Regions registered so far this frame
+  static int GetBlockingRegionCount() { return (int)blockingRegions_.size(); }
+
 private:
   static std::vector<BlockingRegion> blockingRegions_;
   static std::vector<BlockingRegion>
@@ -93,6 +96,7 @@ public:
   }
   static bool IsBlockedByHigherLayer(int, Vector2) { return false; }
   static void ConsumeInput() {}
+  static int GetBlockingRegionCount() { return 0; }
 };
 
 #endif // RAYM3_USE_INPUT_LAYERS
@@ -57,6 +57,8 @@ public:
   // Check if a bounds should receive input
   static bool ShouldReceiveInput(Rectangle bounds, int layerId);
 
+  static int GetQueueSize() { return (int)renderQueue_.size(); }
+
 private:
   static std::vector<RenderCommand> renderQueue_;
   static int currentLayerId_;
@@ -88,6 +90,7 @@ public:
     return {0, 0, 0, 0};
   }
   static bool ShouldReceiveInput(Rectangle, int) { return true; }
+  static int GetQueueSize() { return 0; }
 };
 
 #endif // RAYM3_USE_INPUT_LAYERS
@@ -8,6 +8,9 @@
 #include "raym3/components/TabBar.h"          // Include for TabBar component
 #include "raym3/components/Tooltip.h"         // Include for Tooltip API
 #include "raym3/components/View3D.h" // Include for View3D class
+#include "raym3/rendering/DamageTracker.h" // Include for DamageStats
+#include "raym3/rendering/PerfCounters.h"  // Include for PerfStats
+#include "raym3/rendering/PrewarmManifest.h" // Include for PrewarmCallback
 #include "raym3/styles/Theme.h"
 #include "raym3/types.h"
 #include <raylib.h>
@@ -15,6 +18,8 @@
 
 namespace raym3 {
 
+class RenderBackend;
+
 void Initialize();
 void Shutdown();
 
@@ -27,6 +32,90 @@ void SetScissorDebug(bool enabled);
 bool IsScissorDebug();
 void DrawScissorDebug();
 
+// Record raym3 drawing into a frame-level command buffer and emit it as
+// merged texture/scissor batches at EndFrame(). Off by default. When enabled,
+// call FlushDrawBatch() before drawing with raylib directly mid-frame.
+// Partial redraw batches regardless of this setting while it is on;
+// IsDrawBatching() reports whether drawing is batched, and this setting
+// applies again once partial redraw is turned off.
+void SetDrawBatching(bool enabled);
+bool IsDrawBatching();
+void FlushDrawBatch();
+
+// Draw rounded rectangles, outlines and shadows with an SDF shader (one quad
+// per shape) instead of tessellated geometry. Off by default. Falls back to
+// tessellation on GLSL 100 contexts.
+void SetSdfShapes(bool enabled);
+bool IsSdfShapesEnabled();
+
+// Draw text from one distance-field atlas per font weight, scaled to any size
+// by a shader, instead of rasterizing glyphs for every pixel size. Off by
+// default. Falls back to bitmap glyphs where SDF shaders are unavailable.
+void SetSdfText(bool enabled);
+bool IsSdfTextEnabled();
+
+// Draw icons from one distance field per (name, variation), scaled to any
+// size by a shader, instead of rasterizing each size. Off by default. Falls
+// back to rasterized icons where SDF shaders are unavailable.
+void SetSdfIcons(bool enabled);
+bool IsSdfIconsEnabled();
+
+// Queue every size of the Theme typography scale for glyph rasterization,
+// on a worker thread when built with RAYM3_ASYNC_FONTS, so opening a screen
+// with a new text size does not stall. Call after Initialize().
+void PrewarmFonts(FontWeight weight = FontWeight::Regular);
+
+// Bake the icons and font sizes a prewarm manifest lists (see
+// PrewarmManifest) on the worker threads and upload them in one pass, so
+// first draws do not stall. Call after Initialize(); blocks until done,
+// calling progress on this thread. False if the file cannot be read.
+bool PrewarmFromManifest(const char *path,
+                         const PrewarmCallback &progress = nullptr);
+// Record every icon and font size drawn from now on, to save as a manifest
+// to ship with the app. Saving does not stop the recording.
+void StartPrewarmRecording();
+bool SavePrewarmRecording(const char *path);
+
+// Keep rasterized glyphs in `directory` across runs, so later starts map them
+// from disk instead of rendering them from the TTF data. Off (nullptr) by
+// default. Set it before drawing text; new glyphs are written at Shutdown().
+void SetFontCacheDirectory(const char *directory);
+
+// Rasterize icons missing from the atlas on worker threads and upload them at
+// the next BeginFrame(), within a time budget, instead of stalling the frame
+// that first draws them; until then nothing is drawn in their place. Needs
+// RAYM3_ASYNC_ICONS; off by default.
+void SetAsyncIcons(bool enabled);
+// Finish and upload every queued icon, e.g. before a screenshot.
+void WaitForPendingIcons();
+
+// Replace the backend that executes raym3 drawing and owns its textures
+// (default: raylib). Set it before Initialize(); nullptr restores raylib.
+// See SoftwareBackend for headless rendering.
+void SetRenderBackend(RenderBackend *backend);
+RenderBackend *GetRenderBackend();
+
+// Keep the last frame in a retained surface and repaint only regions whose
+// draw commands changed (batches drawing while on; see SetDrawBatching()).
+// background fills repainted regions first; alpha 0 uses the theme's
+// surface color. Frames that flush mid-frame (View3D, FlushDrawBatch()) are
+// repainted fully. Report raylib drawing raym3 does not record with
+// InvalidateRegion().
+void SetPartialRedraw(bool enabled, Color background = {0, 0, 0, 0});
+bool IsPartialRedraw();
+void InvalidateRegion(Rectangle bounds);
+// Outline repainted regions and show the repainted percentage.
+void SetDamageDebug(bool enabled);
+bool IsDamageDebug();
+DamageStats GetDamageStats();
+
+// Per-frame counters: draw calls, text, cache hits, layout, input queues and
+// (with RAYM3_COUNT_ALLOCATIONS) heap allocations. GetPerfStats() returns the
+// last completed frame; the HUD draws them in the top-right corner.
+void SetPerfHud(bool enabled);
+bool IsPerfHud();
+PerfStats GetPerfStats();
+
 void BeginFrame();
 void EndFrame();
 
@@ -45,6 +134,9 @@ void BeginContainer(Rectangle bounds,
 void EndContainer();
 
 void SetIconBasePath(const char *path);
+// Read icons from a pack built by the icon_pack target (see IconPack)
+// before the SVG directories. nullptr closes it.
+bool LoadIconPack(const char *path);
 
 bool Button(const char *text, Rectangle bounds,
             ButtonVariant variant = ButtonVariant::Filled);
@@ -85,6 +177,12 @@ void Icon(const char *name, Rectangle bounds,
 void Text(const char *text, Rectangle bounds, float fontSize, Color color,
           FontWeight weight = FontWeight::Regular,
           TextAlignment alignment = TextAlignment::Left);
+// Word-wrapped paragraph, cut with "..." after maxLines or the lines bounds
+// fits.
+void TextWrapped(const char *text, Rectangle bounds, float fontSize,
+                 Color color, FontWeight weight = FontWeight::Regular,
+                 TextAlignment alignment = TextAlignment::Left,
+                 int maxLines = 0);
 
 void Card(Rectangle bounds, CardVariant variant = CardVariant::Elevated);
 bool Dialog(const char *title, const char *message, const char *buttons);
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "raym3/rendering/DrawCommandBuffer.h"
+#include <cstdint>
+#include <raylib.h>
+#include <vector>
+
+namespace raym3 {
+
+struct DamageStats {
+  int regions = 0;               // Rectangles repainted last frame
+  float repaintedPercent = 0.0f; // Share of the surface's pixels repainted
+  bool fullRedraw = false;       // Whole surface repainted
+};
+
+// Partial redraw. While enabled, each frame's recorded commands are compared
+// with the previous frame's; the bounds of every command that appeared,
+// disappeared or changed (color, geometry, glyphs, scissor) are damaged.
+// DrawCommandBuffer then repaints only the damaged regions into the backend's
+// retained surface, clipping each replay with the scissor state.
+//
+// Content raym3 does not record (raw raylib drawing) must be reported with
+// Invalidate(). A mid-frame DrawCommandBuffer::Flush() (View3D, custom
+// shaders) draws straight to the screen, so such frames fall back to a full
+// redraw.
+class DamageTracker {
+public:
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled() { return enabled_; }
+
+  // Color repainted regions are cleared to. Alpha 0 follows the theme's
+  // surface color.
+  static void SetBackground(Color color) { background_ = color; }
+  static Color GetBackground();
+
+  static void Invalidate(Rectangle bounds);
+  static void InvalidateAll() { invalidateAll_ = true; }
+  // A region drawn after the frame's commands (debug overlay, HUD). It is
+  // repainted next frame only where the backend retains overlays, and is
+  // left out of GetStats().
+  static void InvalidateOverlay(Rectangle bounds);
+
+  // Diffs the frame against the previous one and returns the regions to
+  // repaint, in whole pixels and clipped to the surface. surfaceIntact is
+  // false when the retained surface lost its pixels.
+  static const std::vector<Rectangle> &
+  ComputeDamage(const std::vector<DrawCommand> &commands,
+                const std::vector<TexturedQuad> &quads,
+                const std::vector<Rectangle> &scissors, bool surfaceIntact);
+  // Forgets the previous frame so the next tracked frame repaints fully.
+  static void Discard();
+
+  // Outlines last frame's damage on screen with the repainted percentage.
+  static void SetDebugOverlay(bool enabled) { debugOverlay_ = enabled; }
+  static bool IsDebugOverlay() { return debugOverlay_; }
+  static void DrawDebugOverlay();
+
+  static const DamageStats &GetStats() { return stats_; }
+
+private:
+  struct Signature {
+    uint64_t hash;
+    Rectangle bounds; // Command bounds clipped to its scissor
+  };
+
+  static bool enabled_;
+  static bool debugOverlay_;
+  static bool invalidateAll_;
+  static Color background_;
+  static Color lastBackground_;
+  static int lastWidth_;
+  static int lastHeight_;
+  static std::vector<Signature> previous_;
+  static std::vector<Signature> current_;
+  static std::vector<Rectangle> invalidated_;
+  static std::vector<Rectangle> overlays_;
+  static std::vector<Rectangle> damage_;
+  // damage_ before overlay repaints were added: what changed, which the
+  // debug overlay outlines and the stats count.
+  static std::vector<Rectangle> contentDamage_;
+  static DamageStats stats_;
+
+  static void AddRegion(Rectangle region);
+  // Grown to whole pixels plus the anti-aliasing fringe.
+  static void AddChanged(Rectangle changed, Rectangle screen);
+};
+
+} // namespace raym3
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <raylib.h>
+#include <vector>
+
+namespace raym3 {
+
+enum class DrawCommandType : uint8_t {
+  Rectangle,
+  RectangleLines,
+  RoundedRectangle,
+  RoundedRectangleLines,
+  Ring, // Circles and circle sectors are rings with a zero inner radius
+  Line,
+  Triangle,
+  Quads, // Textured quads (glyph runs, icons) stored in the quad arena
+  SdfRectangle, // Rounded rect/outline/shadow drawn by SdfRenderer
+  SdfQuads // Quads whose texture alpha is a distance field (SDF text)
+};
+
+struct RectParams {
+  Rectangle rec;
+  float roundness;
+  float lineWidth;
+};
+
+struct RingParams {
+  Vector2 center;
+  float innerRadius;
+  float outerRadius;
+  float startAngle;
+  float endAngle;
+};
+
+struct LineParams {
+  Vector2 start;
+  Vector2 end;
+  float thickness;
+};
+
+struct TriangleParams {
+  Vector2 v1;
+  Vector2 v2;
+  Vector2 v3;
+};
+
+struct SdfParams {
+  Rectangle rec;
+  float radius;
+  float lineWidth;
+  float softness;
+};
+
+struct QuadParams {
+  uint32_t firstQuad;
+  uint32_t quadCount;
+  float textureWidth;
+  float textureHeight;
+};
+
+// One recorded primitive. Kept POD so a frame's worth of commands is a flat
+// array that can be reordered without touching the heap.
+struct DrawCommand {
+  DrawCommandType type;
+  uint8_t segments;
+  uint16_t scissor;       // Index into the scissor table, 0 = no scissor
+  unsigned int textureId; // Shapes texture for untextured primitives, 0 for
+                          // SDF shapes so they only batch with each other
+  Color color;
+  Rectangle bounds; // Conservative screen-space AABB used for overlap tests
+  union {
+    RectParams rect;
+    RingParams ring;
+    LineParams line;
+    TriangleParams triangle;
+    QuadParams quads;
+    SdfParams sdf;
+  };
+  int next; // Next command in the same batch, -1 terminates
+};
+
+struct TexturedQuad {
+  Rectangle source;
+  Rectangle dest;
+};
+
+struct DrawBatchStats {
+  int commands = 0; // Primitives recorded
+  int batches = 0;  // Texture/scissor runs emitted to the backend
+  int vertices = 0; // Approximate vertices of the executed commands
+  int flushes = 0;  // Buffer flushes (frame end and explicit barriers)
+};
+
+// Frame-level buffer behind Renderer. While enabled, primitives submitted
+// between BeginFrame() and EndFrame() are recorded instead of drawn. On flush
+// they are merged into (texture, scissor) batches, moving a command earlier
+// only past batches it does not overlap, so paint order is preserved wherever
+// it is visible. While disabled every command is drawn immediately.
+class DrawCommandBuffer {
+public:
+  // The caller's setting. Partial redraw records regardless while it is on
+  // and calls SyncEnabled() when it changes, so turning it off restores this.
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled() { return enabled_; }
+  static void SyncEnabled();
+
+  static void BeginFrame();
+  static void EndFrame();
+
+  // Records (or immediately draws) a primitive. A DrawCommandType::Quads
+  // command covers the quads added since QuadCount() was read.
+  static void Submit(DrawCommand cmd);
+  static uint32_t QuadCount() { return (uint32_t)quads_.size(); }
+  static void AddQuad(Rectangle source, Rectangle dest) {
+    quads_.push_back({source, dest});
+  }
+
+  // Scissor state is part of the recorded stream; it is only applied to the
+  // GPU when the batch that needs it is emitted.
+  static void SetScissor(Rectangle bounds);
+  static void ClearScissor();
+
+  // Emits everything recorded so far and leaves the backend scissor matching
+  // the current scissor state. Code that draws through raylib directly
+  // (shaders, render textures) must flush first. With partial redraw on, a
+  // flush before EndFrame() makes the frame a full redraw.
+  static void Flush();
+
+  // Counters for the last completed frame.
+  static const DrawBatchStats &GetFrameStats() { return lastFrameStats_; }
+
+private:
+  struct Batch {
+    uint64_t key;
+    Rectangle bounds;
+    int first;
+    int last;
+    int count;
+  };
+
+  static bool requested_; // SetEnabled() value
+  static bool enabled_;   // requested_ or partial redraw on
+  static bool recording_;
+  static bool flushedMidFrame_;
+  static std::vector<DrawCommand> commands_;
+  static std::vector<TexturedQuad> quads_;
+  static std::vector<Batch> batches_;
+  static std::vector<Rectangle> scissors_;
+  static uint16_t currentScissor_;
+  static bool scissorApplied_;
+  static Rectangle appliedScissor_;
+  static DrawBatchStats frameStats_;
+  static DrawBatchStats lastFrameStats_;
+
+  static void BuildBatches();
+  static bool BatchOverlaps(const Batch &batch, Rectangle bounds);
+  // clip restricts emission to one damaged region: commands outside it are
+  // skipped and scissors are intersected with it.
+  static void EmitBatches(const Rectangle *clip = nullptr);
+  static void EmitAll();
+  static void EmitDamaged();
+  static void ApplyScissor(const Rectangle *bounds);
+  static void Reset();
+};
+
+} // namespace raym3
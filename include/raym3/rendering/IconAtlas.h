@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <raylib.h>
+#include <vector>
+
+namespace raym3 {
+
+struct IconAtlasStats {
+  int pages = 0;      // Live page textures
+  int icons = 0;      // Allocated slots
+  int uploads = 0;    // Sub-image updates
+  float usage = 0.0f; // Allocated area / page area
+  size_t bytes = 0;   // Page texture memory
+};
+
+// Where an icon was packed: its page and texel rect, without the padding.
+struct IconSlot {
+  int page = -1;
+  Rectangle rect = {0, 0, 0, 0};
+};
+
+// Gray-alpha pages shared by every rasterized icon, so icons of any name, size
+// and variation batch together. Each page is packed with shelves: a row per
+// icon height, filled left to right, whose freed spans are reused and which
+// are dropped once empty at the bottom of the page. Icons are uploaded with
+// a sub-image update; an icon too large for a page gets a page of its own.
+//
+// Between BeginBatch() and EndBatch(), pages created are kept in memory and
+// their textures are created from them at EndBatch(), so a burst of icons (a
+// prewarm, a frame's finished async icons) costs one upload per new page
+// instead of one per icon. Icons added to older pages are still uploaded as
+// they are added.
+//
+// Free() takes effect at EndFrame(), once the frame's recorded draws have
+// been flushed, so a slot is never overwritten while a draw still samples
+// it. Pages left empty are unloaded then too.
+class IconAtlas {
+public:
+  // Packs a width x height gray-alpha bitmap with a transparent border.
+  // Returns false if no texture could be created for it; for a page created
+  // in a batch that is only known at EndBatch(), which retries it.
+  static bool Add(const unsigned char *grayAlpha, int width, int height,
+                  IconSlot *slot);
+  static void Free(const IconSlot &slot);
+
+  // Batches nest; the outermost EndBatch() creates the new pages' textures.
+  // Nothing drawn from a page created in the batch shows until then.
+  static void BeginBatch() { batchDepth_++; }
+  static void EndBatch();
+
+  // Page texture. Stable while the page holds icons.
+  static Texture2D GetTexture(int page);
+  static int GetPageCount() { return stats_.pages; }
+
+  static void EndFrame();
+  static void Shutdown();
+
+  static const IconAtlasStats &GetStats() { return stats_; }
+
+private:
+  struct Span {
+    int x;
+    int width;
+  };
+
+  struct Shelf {
+    int y;
+    int height;
+    int icons;
+    std::vector<Span> free; // Sorted by x, never adjacent
+  };
+
+  struct Page {
+    Texture2D texture; // id 0 while the page is unused or still staged
+    int width;
+    int height;
+    int top; // First row below the last shelf
+    int icons;
+    std::vector<Shelf> shelves;
+    // Pixels of a page created during a batch, until EndBatch() creates its
+    // texture from them. Kept if that fails, for the next EndBatch().
+    std::vector<unsigned char> staging;
+
+    bool InUse() const { return texture.id != 0 || !staging.empty(); }
+  };
+
+  static std::vector<Page> pages_;
+  static std::vector<IconSlot> freed_; // Released at EndFrame()
+  static IconAtlasStats stats_;
+  static int batchDepth_;
+
+  static int CreatePage(int width, int height);
+  static bool Pack(Page &page, int width, int height, int *x, int *y);
+  static void Release(Page &page, int x, int y, int width);
+  static void UpdateUsage();
+};
+
+} // namespace raym3
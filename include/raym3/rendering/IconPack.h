@@ -0,0 +1,73 @@
+#pragma once
+
+#include "raym3/rendering/MappedFile.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct NSVGimage;
+
+namespace raym3 {
+
+class SvgModel;
+
+// One icon for IconPack::Write(): an Encode()d shape list, or the SVG text
+// when Encode() cannot represent it.
+struct IconPackEntry {
+  int variation; // IconVariation
+  std::string name;
+  std::vector<unsigned char> data;
+  bool svg;
+};
+
+struct IconPackStats {
+  int entries = 0;
+  size_t bytes = 0; // File size
+};
+
+// A prebaked set of icons in one file, built from resources/icons by the
+// raym3_icon_pack tool (the `icon_pack` target), so an app ships one file
+// instead of thousands of SVGs and an icon's first use skips the XML parse.
+//
+// The pack holds each icon's shapes as nanosvg leaves them after parsing:
+// fill and stroke paint, and paths of cubic Beziers whose points are
+// quantized to a power-of-two step (1/1024 unit for 24-unit Material icons)
+// and delta coded, with lines stored as their end point only. Entries are
+// grouped by variation and sorted by name, and are found by binary search in
+// the mapped file; nothing is decoded until an icon is asked for. Icons using
+// features the encoding lacks (gradients, dashes) are stored as SVG text.
+//
+// Open() and Close() run on the main thread; Contains() and Decode() may be
+// called from any thread while the pack is open.
+class IconPack {
+public:
+  static bool Open(const std::string &path);
+  static void Close();
+  static bool IsOpen() { return file_ != nullptr; }
+  static const std::string &GetPath() { return path_; }
+
+  static bool Contains(int variation, const char *name);
+  // Replaces model's image with the entry's shapes. False if the icon is not
+  // in the pack.
+  static bool Decode(int variation, const char *name, SvgModel *model);
+
+  static const IconPackStats &GetStats() { return stats_; }
+
+  // Build side, used by the tool. False if image has paint the pack cannot
+  // store.
+  static bool Encode(const NSVGimage *image, std::vector<unsigned char> *out);
+  // Entries may be in any order.
+  static bool Write(const std::string &path,
+                    std::vector<IconPackEntry> entries);
+
+private:
+  static const unsigned char *Find(int variation, const char *name,
+                                   size_t *size, bool *svg);
+
+  static std::unique_ptr<MappedFile> file_;
+  static std::string path_;
+  static IconPackStats stats_;
+};
+
+} // namespace raym3
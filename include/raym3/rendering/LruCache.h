@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+
+namespace raym3 {
+
+struct LruCacheStats {
+  int hits = 0;
+  int misses = 0;
+  int evictions = 0;
+  int entries = 0;
+};
+
+// Mixes value into h, for hashing keys of several fields.
+inline void HashCombine(uint64_t &h, uint64_t value) {
+  h ^= value + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+}
+
+// Hashes a float key field by its bits; keys compare floats with ==.
+inline uint64_t FloatBits(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// A map that keeps its entries in use order, for the text measure, text
+// layout and SVG document caches. Find() moves a hit to the front and
+// eviction takes from the back.
+//
+// The cache counts hits, misses, evictions and entries in Stats, which is
+// LruCacheStats or a struct with the same fields plus the owner's own.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Stats = LruCacheStats>
+class LruCache {
+public:
+  // The value for key, made the most recently used, or nullptr. Counts a
+  // hit or a miss.
+  Value *Find(const Key &key) {
+    Value *value = Touch(key);
+    if (value)
+      stats_.hits++;
+    else
+      stats_.misses++;
+    return value;
+  }
+
+  // Find() without counting.
+  Value *Touch(const Key &key) {
+    auto it = index_.find(key);
+    if (it == index_.end())
+      return nullptr;
+    order_.splice(order_.begin(), order_, it->second);
+    return &it->second->value;
+  }
+
+  bool Contains(const Key &key) const { return index_.count(key) != 0; }
+
+  // Adds key, which must not be present, as the most recently used entry
+  // and returns its value for the caller to fill in. With maxEntries held,
+  // the oldest entry is evicted and its node reused, so a full cache does
+  // not allocate; the value then still holds the evicted contents, whose
+  // storage the caller may reuse.
+  Value &Insert(const Key &key, size_t maxEntries = SIZE_MAX) {
+    if (!order_.empty() && order_.size() >= maxEntries) {
+      auto oldest = std::prev(order_.end());
+      index_.erase(oldest->key);
+      oldest->key = key;
+      order_.splice(order_.begin(), order_, oldest);
+      stats_.evictions++;
+    } else {
+      order_.push_front({key, Value{}});
+    }
+    index_[key] = order_.begin();
+    stats_.entries = (int)order_.size();
+    return order_.front().value;
+  }
+
+  // The least recently used value; the cache must not be empty.
+  const Value &Oldest() const { return order_.back().value; }
+
+  void EvictOldest() {
+    index_.erase(order_.back().key);
+    order_.pop_back();
+    stats_.evictions++;
+    stats_.entries = (int)order_.size();
+  }
+
+  // Evicts the least recently used entries beyond maxEntries.
+  void Trim(size_t maxEntries) {
+    while (order_.size() > maxEntries)
+      EvictOldest();
+  }
+
+  size_t Size() const { return order_.size(); }
+
+  void Clear() {
+    order_.clear();
+    index_.clear();
+    stats_.entries = 0;
+  }
+
+  const Stats &GetStats() const { return stats_; }
+  Stats &GetStats() { return stats_; }
+  // Zeroes the counters; entries still counts what is held.
+  void ResetStats() {
+    int entries = stats_.entries;
+    stats_ = {};
+    stats_.entries = entries;
+  }
+
+private:
+  struct Entry {
+    Key key;
+    Value value;
+  };
+
+  std::list<Entry> order_; // Most recently used first
+  std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index_;
+  Stats stats_;
+};
+
+} // namespace raym3
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace raym3 {
+
+// Counters for one frame, from BeginFrame() to EndFrame().
+struct PerfStats {
+  double frameMs = 0.0; // CPU time between BeginFrame() and EndFrame()
+
+  // Drawing
+  int drawCommands = 0; // Primitives submitted
+  int drawCalls = 0;    // Texture/scissor batches handed to the backend
+  int vertices = 0;     // Vertices emitted for those batches
+  int flushes = 0;      // Command buffer flushes
+
+  // Text
+  int textMeasures = 0;
+  int textCacheHits = 0;   // Measurements served by TextMeasureCache
+  int textCacheMisses = 0;
+  int textDraws = 0;
+
+  // Caches. Rasterizations are cache misses that produced a texture.
+  int fontCacheHits = 0;
+  int fontCacheMisses = 0;
+  int fontRasterizations = 0;
+  int iconCacheHits = 0;
+  int iconCacheMisses = 0;
+  int iconRasterizations = 0;
+  int shadowCacheHits = 0;
+  int shadowCacheMisses = 0;
+
+  // Layout
+  int layoutNodes = 0;  // Yoga nodes created
+  int layoutPasses = 0; // YGNodeCalculateLayout calls
+  double layoutMs = 0.0;
+
+  // Input (sizes at EndFrame())
+  int blockingRegions = 0;
+  int renderQueue = 0;
+
+  // Heap (operator new). -1 unless built with RAYM3_COUNT_ALLOCATIONS.
+  int64_t allocations = -1;
+  int64_t allocatedBytes = -1;
+};
+
+// Per-frame instrumentation. Subsystems bump Frame() as they work; the
+// snapshot taken at EndFrame() is readable with GetLastFrame() and shown by
+// the HUD.
+class PerfCounters {
+public:
+  // Counters of the frame in progress.
+  static PerfStats &Frame() { return frame_; }
+  static const PerfStats &GetLastFrame() { return lastFrame_; }
+
+  static void BeginFrame();
+  static void EndFrame();
+
+  // Counter panel in the top-right corner, drawn at EndFrame().
+  static void SetHudEnabled(bool enabled) { hudEnabled_ = enabled; }
+  static bool IsHudEnabled() { return hudEnabled_; }
+  static void DrawHud();
+
+private:
+  static PerfStats frame_;
+  static PerfStats lastFrame_;
+  static bool hudEnabled_;
+  static std::chrono::steady_clock::time_point frameStart_;
+  static int64_t allocationsAtStart_;
+  static int64_t allocatedBytesAtStart_;
+};
+
+// Adds the lifetime of the scope, in milliseconds, to a counter.
+class PerfTimer {
+public:
+  explicit PerfTimer(double &ms)
+      : ms_(ms), start_(std::chrono::steady_clock::now()) {}
+  ~PerfTimer() {
+    ms_ += std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start_)
+               .count();
+  }
+
+private:
+  double &ms_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace raym3
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "raym3/types.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace raym3 {
+
+struct PrewarmIcon {
+  std::string name;
+  IconVariation variation;
+  // Pixels; the raster size buckets they fall in are baked.
+  int size;       // Width
+  int height = 0; // 0 for a square icon
+};
+
+struct PrewarmFont {
+  FontWeight weight;
+  int size;
+};
+
+struct PrewarmProgress {
+  int done = 0;  // Icons and font sizes baked
+  int total = 0; // Entries in the manifest
+};
+
+using PrewarmCallback = std::function<void(const PrewarmProgress &)>;
+
+// Icons and font sizes to bake at startup, so the first frame of each screen
+// does not stall on them. A manifest is a text file with one entry a line:
+//
+//   # Comments and blank lines are ignored
+//   icon filled 24 home
+//   icon outlined 20 search
+//   icon round 32x24 chevron_right
+//   font regular 16
+//   font bold 22
+//
+// An icon size is its width and height, or one number for a square icon.
+// Variations are the icon folder names (filled, outlined, round, sharp,
+// two-tone); weights are thin, light, regular, medium, bold and black.
+//
+// Bake() queues every entry on the icon and glyph worker pools (or bakes it
+// on the calling thread without RAYM3_ASYNC_ICONS / RAYM3_ASYNC_FONTS),
+// reports progress while they run, then packs the results into the atlases
+// and uploads them in one pass.
+//
+// Rather than being written by hand, a manifest is usually recorded from a
+// real session: between StartRecording() and StopRecording() every icon and
+// font size drawn is added to GetRecording(), which Save() writes out.
+class PrewarmManifest {
+public:
+  std::vector<PrewarmIcon> icons;
+  std::vector<PrewarmFont> fonts;
+
+  // Replaces the entries with the file's. Malformed lines are skipped with a
+  // warning. False if the file cannot be read.
+  bool Load(const std::string &path);
+  bool Parse(const std::string &text);
+  bool Save(const std::string &path) const;
+  std::string ToString() const;
+
+  // Call after Initialize(). Blocks until every entry is baked and
+  // uploaded; progress, if set, is called on this thread as entries finish.
+  void Bake(const PrewarmCallback &progress = nullptr) const;
+
+  // Recording restarts from an empty manifest.
+  static void StartRecording();
+  static void StopRecording() { recording_ = false; }
+  static bool IsRecording() { return recording_; }
+  static const PrewarmManifest &GetRecording() { return recorded_; }
+
+  // Called by SvgRenderer and FontManager while recording. iconId is the
+  // IconHandle id, used to skip entries already recorded without string
+  // work.
+  static void RecordIcon(int iconId, const std::string &name,
+                         IconVariation variation, int width, int height);
+  static void RecordFont(FontWeight weight, int size);
+
+private:
+  static bool recording_;
+  static PrewarmManifest recorded_;
+  static std::unordered_set<uint64_t> recordedKeys_;
+};
+
+} // namespace raym3
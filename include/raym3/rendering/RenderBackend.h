@@ -0,0 +1,108 @@
+#pragma once
+
+#include "raym3/rendering/DrawCommandBuffer.h"
+#include <raylib.h>
+
+namespace raym3 {
+
+// Executes draw commands emitted by DrawCommandBuffer and owns the textures
+// they sample. The default backend draws through raylib/rlgl; a different
+// one (e.g. SoftwareBackend) can be installed with SetRenderBackend() before
+// raym3 is initialized, so fonts and icons are created by it.
+class RenderBackend {
+public:
+  virtual ~RenderBackend() = default;
+
+  // False when there is no raylib GL context. GPU-only features (View3D
+  // scenes, the SDF shader) are skipped or drawn as placeholders.
+  virtual bool HasGpuContext() const = 0;
+  // Whether SdfRectangle commands can be executed.
+  virtual bool SupportsSdf() = 0;
+  // Whether SdfQuads commands can be executed. FontManager falls back to
+  // bitmap glyphs when they cannot.
+  virtual bool SupportsSdfText() { return SupportsSdf(); }
+
+  // Size of the surface raym3 draws to; used in place of raylib's screen
+  // size for scissor clamping and screen-sized overlays.
+  virtual int GetScreenWidth() const = 0;
+  virtual int GetScreenHeight() const = 0;
+
+  virtual Texture2D LoadTexture(const Image &image) = 0;
+  virtual void UnloadTexture(Texture2D texture) = 0;
+  virtual void SetTextureFilter(Texture2D texture, int filter) {}
+  // Replaces a region of a texture; pixels are tightly packed in the format
+  // of the image the texture was loaded from.
+  virtual void UpdateTexture(Texture2D texture, Rectangle region,
+                             const void *pixels) = 0;
+
+  // A batch is a run of commands sharing texture and scissor. quads is the
+  // frame's quad arena that Quads commands index into.
+  virtual void BeginBatch() {}
+  virtual void Execute(const DrawCommand &cmd, const TexturedQuad *quads) = 0;
+  virtual void EndBatch() {}
+
+  // bounds == nullptr disables clipping.
+  virtual void SetScissor(const Rectangle *bounds) = 0;
+
+  // Retained surface for partial redraw (DamageTracker). BeginRetained()
+  // redirects drawing to a surface that keeps its pixels between frames and
+  // returns false when they were lost (first use, resize). ClearRegion()
+  // overwrites a region ignoring blending and scissor; EndRetained() presents
+  // the surface.
+  virtual bool BeginRetained() = 0;
+  virtual void ClearRegion(Rectangle region, Color color) = 0;
+  virtual void EndRetained() = 0;
+  virtual void ReleaseRetained() {}
+  // Whether drawing after EndRetained() (debug overlays, the HUD) lands in
+  // the retained surface, and so must be painted over next frame. False
+  // when the surface is presented underneath it.
+  virtual bool RetainsOverlays() const { return false; }
+
+  static RenderBackend *Get() { return current_; }
+  static Rectangle GetScreenBounds() {
+    return {0, 0, (float)current_->GetScreenWidth(),
+            (float)current_->GetScreenHeight()};
+  }
+  // nullptr restores the raylib backend.
+  static void Set(RenderBackend *backend);
+
+private:
+  static RenderBackend *current_;
+};
+
+// Draws through raylib and rlgl. Requires a window/GL context.
+class RaylibBackend : public RenderBackend {
+public:
+  bool HasGpuContext() const override { return true; }
+  bool SupportsSdf() override;
+  bool SupportsSdfText() override;
+  int GetScreenWidth() const override { return ::GetScreenWidth(); }
+  int GetScreenHeight() const override { return ::GetScreenHeight(); }
+
+  Texture2D LoadTexture(const Image &image) override;
+  void UnloadTexture(Texture2D texture) override;
+  void SetTextureFilter(Texture2D texture, int filter) override;
+  void UpdateTexture(Texture2D texture, Rectangle region,
+                     const void *pixels) override;
+
+  void BeginBatch() override;
+  void Execute(const DrawCommand &cmd, const TexturedQuad *quads) override;
+  void EndBatch() override;
+
+  void SetScissor(const Rectangle *bounds) override;
+
+  bool BeginRetained() override;
+  void ClearRegion(Rectangle region, Color color) override;
+  void EndRetained() override;
+  void ReleaseRetained() override;
+
+private:
+  unsigned int quadTexture_ = 0; // Texture of the open RL_QUADS run, 0 = none
+  bool quadSdf_ = false;         // The open run uses the SDF text shader
+  RenderTexture2D retained_ = {};
+
+  void EndQuads();
+  static void EmitQuads(const DrawCommand &cmd, const TexturedQuad *quads);
+};
+
+} // namespace raym3
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <raylib.h>
 #include "raym3/types.h"
 #include "raym3/styles/Theme.h"
@@ -14,12 +15,38 @@ public:
     static void DrawStateLayer(Rectangle bounds, float cornerRadius, Color baseColor, ComponentState state);
     static void DrawText(const char* text, Vector2 position, float fontSize, Color color, FontWeight weight = FontWeight::Regular);
     static void DrawTextCentered(const char* text, Rectangle bounds, float fontSize, Color color, FontWeight weight = FontWeight::Regular);
-    
-    static Vector2 MeasureText(const char* text, float fontSize, FontWeight weight = FontWeight::Regular);
-    
+    static void DrawTextEx(Font font, const char* text, Vector2 position, float fontSize, float spacing, Color color);
+
+    // Results are memoized in TextMeasureCache. textHash may be a precomputed TextMeasureCache::Hash(text) for stable labels; 0 hashes text.
+    static Vector2 MeasureText(const char* text, float fontSize, FontWeight weight = FontWeight::Regular, uint64_t textHash = 0);
+    // raylib's MeasureTextEx, cached and counted in PerfCounters.
+    static Vector2 MeasureTextEx(Font font, const char* text, float fontSize, float spacing, uint64_t textHash = 0);
+
+    // Basic primitives. Components draw through these instead of raylib so
+    // that everything goes through the frame's DrawCommandBuffer.
+    static void DrawRectangle(Rectangle bounds, Color color);
+    static void DrawRectangleLines(Rectangle bounds, float lineWidth, Color color);
+    static void DrawCircle(Vector2 center, float radius, Color color);
+    static void DrawCircleSector(Vector2 center, float radius, float startAngle, float endAngle, int segments, Color color);
+    static void DrawRing(Vector2 center, float innerRadius, float outerRadius, float startAngle, float endAngle, int segments, Color color);
+    static void DrawLine(Vector2 start, Vector2 end, float thickness, Color color);
+    static void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color);
+    static void DrawTexture(Texture2D texture, Rectangle source, Rectangle dest, Color tint);
+    // texture's alpha is a distance field encoded like raylib's FONT_SDF
+    // glyphs; drawn with the SDF text shader. Needs SupportsSdfText().
+    static void DrawSdfTexture(Texture2D texture, Rectangle source, Rectangle dest, Color tint);
+
+    // Draw rounded rectangles, outlines and elevation shadows as single
+    // SDF-shaded quads instead of tessellated fans. Off by default; ignored
+    // (tessellation is used) where the GL context cannot run the shader.
+    static void SetSdfShapes(bool enabled);
+    static bool IsSdfShapesEnabled();
+
 private:
+    static bool sdfShapes_;
+
+    static bool UseSdf();
     static void DrawShadow(Rectangle bounds, float cornerRadius, int elevation);
 };
 
 } // namespace raym3
-
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <raylib.h>
+#include <vector>
+
+namespace raym3 {
+
+// A rounded rectangle evaluated analytically in the fragment shader. With
+// lineWidth > 0 only a stroke of that width outside the rectangle is
+// covered; with softness > 0 the edge is blurred with a Gaussian of that
+// sigma (used for elevation shadows).
+struct SdfShape {
+  Rectangle rec;
+  float radius;
+  float lineWidth;
+  float softness;
+  Color color;
+};
+
+// Draws rounded rectangles, outlines and shadows as one quad each using a
+// signed-distance-field shader. Shapes carry their parameters per vertex, so
+// any number of them is a single draw call. Requires GLSL 330 or GLSL ES 300;
+// IsSupported() is false elsewhere and callers fall back to tessellation.
+class SdfRenderer {
+public:
+  // Loads the shader on first call. Needs a GL context.
+  static bool IsSupported();
+  static void Shutdown();
+
+  // Shader for DrawCommandType::SdfQuads: textured quads whose alpha is a
+  // distance field, drawn through rlgl's batch with BeginShaderMode().
+  static bool IsTextSupported();
+  static Shader GetTextShader() { return textShader_; }
+
+  static void Add(const SdfShape &shape);
+  // Draws the shapes added since the last call. Flushes rlgl's pending batch
+  // first so paint order is preserved.
+  static void Draw();
+
+private:
+  struct Vertex {
+    float x, y;
+    float localX, localY;
+    float halfWidth, halfHeight;
+    float radius, lineWidth, softness;
+    unsigned char r, g, b, a;
+  };
+
+  static bool loaded_;
+  static bool supported_;
+  static Shader shader_;
+  static Shader textShader_;
+  static int locMvp_;
+  static int locPosition_;
+  static int locShape_;
+  static int locParams_;
+  static int locColor_;
+  static unsigned int vao_;
+  static unsigned int vbo_;
+  static int capacity_; // Vertices the GPU buffer can hold
+  static std::vector<Vertex> vertices_;
+
+  static void Load();
+  static void EnsureCapacity(int vertexCount);
+};
+
+} // namespace raym3
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <raylib.h>
+#include <unordered_map>
+#include <vector>
+
+namespace raym3 {
+
+struct ShadowCacheStats {
+  int hits = 0;
+  int misses = 0;
+  int evictions = 0;
+  int entries = 0;
+  int bytes = 0; // Texture memory held by cached shadows
+};
+
+// Elevation shadows pre-blurred on the CPU into small nine-slice textures,
+// one per (elevation, corner radius). A shadow of any size is then nine
+// textured quads, so its cost no longer depends on tessellation. The cache
+// holds at most GetCapacity() textures and evicts the least recently used.
+class ShadowCache {
+public:
+  static void SetEnabled(bool enabled) { enabled_ = enabled; }
+  static bool IsEnabled() { return enabled_; }
+
+  static void SetCapacity(int maxEntries);
+  static int GetCapacity() { return capacity_; }
+
+  // Records a nine-slice shadow of bounds blurred with a Gaussian of sigma
+  // softness, which must be the same for every call with this elevation.
+  // Returns false if no shadow texture could be produced.
+  static bool DrawShadow(Rectangle bounds, float cornerRadius, int elevation,
+                         float softness, Color color);
+
+  // Unloads textures evicted during the frame. Called after the frame's draw
+  // commands have been flushed, since recorded quads may still use them.
+  static void EndFrame();
+
+  static void Clear();
+  static void Shutdown();
+
+  static const ShadowCacheStats &GetStats() { return stats_; }
+  static void ResetStats();
+
+private:
+  struct Entry {
+    Texture2D texture;
+    int corner;  // Size of a corner slice in texels
+    int padding; // Blur extent outside the shape in texels
+    uint64_t lastUsed;
+  };
+
+  static bool enabled_;
+  static int capacity_;
+  static uint64_t tick_;
+  static std::unordered_map<uint32_t, Entry> entries_;
+  static std::vector<Texture2D> evicted_;
+  static ShadowCacheStats stats_;
+
+  static Entry *Acquire(int elevation, int radius, float softness);
+  static Entry Bake(int radius, float softness);
+  static void EvictOldest();
+};
+
+} // namespace raym3
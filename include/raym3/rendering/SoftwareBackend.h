@@ -0,0 +1,92 @@
+#pragma once
+
+#include "raym3/rendering/RenderBackend.h"
+#include <unordered_map>
+#include <vector>
+
+namespace raym3 {
+
+// CPU rasterizer that draws raym3 primitives into an in-memory RGBA8
+// framebuffer. Needs no window or GL context, so full frames can be rendered
+// headlessly (CI, golden-image comparisons, CPU frame benchmarks):
+//
+//   raym3::SoftwareBackend backend(800, 600);
+//   raym3::SetRenderBackend(&backend);
+//   raym3::Initialize();
+//   backend.Clear(WHITE);
+//   raym3::BeginFrame(); /* widgets */ raym3::EndFrame();
+//   backend.Export("frame.png");
+//
+// With partial redraw enabled, skip Clear() between frames: the framebuffer
+// is the retained surface and only damaged regions are repainted.
+//
+// Shapes are anti-aliased analytically; textures are sampled nearest, except
+// distance-field text, which is sampled bilinearly and thresholded.
+class SoftwareBackend : public RenderBackend {
+public:
+  SoftwareBackend(int width, int height);
+
+  void Resize(int width, int height);
+  void Clear(Color color);
+
+  int GetWidth() const { return width_; }
+  int GetHeight() const { return height_; }
+  // Row-major, top-down, width * height pixels.
+  const Color *GetPixels() const { return pixels_.data(); }
+  // Image view of the framebuffer. Valid until the next Resize(); do not
+  // unload it.
+  Image GetImage() const;
+  bool Export(const char *path) const;
+
+  bool HasGpuContext() const override { return false; }
+  bool SupportsSdf() override { return true; }
+  int GetScreenWidth() const override { return width_; }
+  int GetScreenHeight() const override { return height_; }
+
+  Texture2D LoadTexture(const Image &image) override;
+  void UnloadTexture(Texture2D texture) override;
+  void UpdateTexture(Texture2D texture, Rectangle region,
+                     const void *pixels) override;
+
+  void Execute(const DrawCommand &cmd, const TexturedQuad *quads) override;
+  void SetScissor(const Rectangle *bounds) override;
+
+  // The framebuffer itself is the retained surface; Clear() and Resize()
+  // discard its contents.
+  bool BeginRetained() override;
+  void ClearRegion(Rectangle region, Color color) override;
+  void EndRetained() override {}
+  // The retained surface is the framebuffer itself.
+  bool RetainsOverlays() const override { return true; }
+
+private:
+  struct SoftTexture {
+    int width;
+    int height;
+    int format; // Format of the source image, used by UpdateTexture()
+    std::vector<Color> pixels;
+  };
+
+  int width_;
+  int height_;
+  std::vector<Color> pixels_;
+  std::vector<unsigned char> coverage_; // One row of per-pixel coverage
+  int clipX0_ = 0, clipY0_ = 0, clipX1_ = 0, clipY1_ = 0;
+  bool retainedValid_ = false;
+  std::unordered_map<unsigned int, SoftTexture> textures_;
+  unsigned int nextTextureId_ = 1;
+
+  template <typename CoverageFn>
+  void FillShape(Rectangle bounds, Color color, CoverageFn coverage);
+
+  void FillRectangle(Rectangle rec, Color color);
+  void FillRoundedRectangle(Rectangle rec, float radius, float lineWidth,
+                            float softness, Color color);
+  void FillRing(const RingParams &ring, Color color);
+  void FillLine(const LineParams &line, Color color);
+  void FillTriangle(const TriangleParams &triangle, Color color);
+  void DrawQuads(const DrawCommand &cmd, const TexturedQuad *quads);
+  void DrawSdfQuads(const DrawCommand &cmd, const TexturedQuad *quads);
+};
+
+} // namespace raym3
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 // Forward declaration
@@ -14,9 +15,13 @@ public:
 
   bool LoadFromFile(const char *filename);
   bool LoadFromString(const char *data);
+  // Takes ownership of an image allocated the way nsvgDelete() frees it.
+  void Adopt(NSVGimage *parsed);
   void Unload();
 
   NSVGimage *GetImage() const { return image; }
+  // Approximate heap size of the parsed shapes and paths.
+  size_t GetMemoryUsage() const;
 
   // Helper to change fill color of all shapes
   void SetColor(unsigned int color); // 0xAABBGGRR (nanosvg format)
@@ -1,17 +1,95 @@
 #pragma once
 
+#include "raym3/rendering/IconAtlas.h"
+#include "raym3/rendering/LruCache.h"
 #include "raym3/types.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <raylib.h>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct NSVGrasterizer;
 
 namespace raym3 {
 
+class SvgModel;
+
+struct SvgDocumentStats {
+  int hits = 0;
+  int misses = 0; // Documents read and parsed
+  int evictions = 0;
+  int entries = 0;
+  size_t bytes = 0; // Estimated size of the parsed documents held
+};
+
+// A (name, variation) pair interned by SvgRenderer::GetIconHandle(), so
+// drawing it needs no string work. Valid until SvgRenderer::Shutdown().
+struct IconHandle {
+  int id = -1;
+  bool IsValid() const { return id >= 0; }
+};
+
+struct SvgIconCacheStats {
+  int entries = 0;  // Rasterized (name, variation, size) icons and fields
+  size_t bytes = 0; // Their texels in the atlas
+  int evictions = 0;
+};
+
+// Icons are rasterized once per (name, variation, size) into the shared
+// IconAtlas and drawn as sub-rects of its pages, so a screen of icons is one
+// batch. The cached icons are bounded by GetIconBudget() bytes: at
+// EndFrame() the least recently drawn ones are evicted until they fit, so
+// resizing or scrolling through many icons keeps a stable footprint.
+//
+// Parsed documents are cached separately, keyed by (name, variation) and
+// bounded by GetDocumentBudget() bytes, least recently used first out, so a
+// new size of a known icon (e.g. while a window is resized) costs only the
+// rasterization: no file read and no XML parse. Rasterizers, and their
+// scratch buffers, are pooled.
+//
+// In SDF mode (SetSdfEnabled()) each (name, variation) is instead rendered
+// once as a distance field at a fixed reference size and drawn at any size,
+// position and scale by the SDF text shader: one cache entry per icon.
+//
+// In async mode (SetAsyncIcons(), when built with RAYM3_ASYNC_ICONS) a miss
+// draws nothing and queues the parse and rasterization on a small worker
+// pool; BeginFrame() packs finished icons into the atlas within
+// GetUploadBudget() milliseconds. Icons appear a frame or more later, in
+// request order: one finished ahead of an earlier request waits for it.
+// WaitForPendingIcons() finishes every queued icon, for tests
+// and screenshots that need the final frame.
 class SvgRenderer {
 public:
+  // Without a path, opens the icon pack built next to the library, or
+  // icons.rm3i under the resources or working directory, before searching
+  // for an icons directory.
   static void Initialize(const char *basePath);
   static void Shutdown();
+  // Looks icons up in the pack at path first (see IconPack). nullptr closes
+  // the pack. False if the file is missing or not a valid pack.
+  static bool LoadIconPack(const char *path);
+  // Uploads icons finished by the workers, at least one per frame.
+  static void BeginFrame();
+  // Called after the frame's draws are flushed. Evicts icons over the budget
+  // and reclaims their atlas slots.
+  static void EndFrame();
 
+  // Interns name on first use; later calls only hash it. Never invalid.
+  static IconHandle
+  GetIconHandle(const char *name,
+                IconVariation variation = IconVariation::Filled);
+  // bounds may be fractional; see SetSizeBuckets().
+  static void DrawIcon(IconHandle icon, Rectangle bounds, Color color = BLACK);
   static void DrawIcon(const char *name, Rectangle bounds,
                        IconVariation variation = IconVariation::Filled,
                        Color color = BLACK);
@@ -19,15 +97,186 @@ public:
   // Helper to get the variation folder name
   static const char *GetVariationFolder(IconVariation variation);
 
+  // On by default: icons are rasterized at the next size bucket up (12, 14,
+  // ..., 24, 28, ..., 48, 56, ..., 96, then steps of 1/8) and scaled to the
+  // exact bounds, so animated or fractional sizes reuse a few rasters. Off
+  // rasterizes every whole-pixel size, rounded up, and draws it unscaled.
+  static void SetSizeBuckets(bool enabled) { sizeBuckets = enabled; }
+  static bool GetSizeBuckets() { return sizeBuckets; }
+  // Raster size used for a requested icon size.
+  static int GetRasterSize(float size);
+
+  // Off by default. When on, and the backend can draw distance fields
+  // (RenderBackend::SupportsSdfText()), icons are drawn from one distance
+  // field each, at the exact bounds, instead of a raster per size.
+  static void SetSdfEnabled(bool enabled) { sdfEnabled = enabled; }
+  static bool IsSdfEnabled();
+
+  // Default 1 MB, two atlas pages. Icons drawn in the current frame are never
+  // evicted, so a frame that needs more goes over until they fall out of use.
+  static void SetIconBudget(size_t bytes) { iconBudget = bytes; }
+  static size_t GetIconBudget() { return iconBudget; }
+  static const SvgIconCacheStats &GetIconCacheStats() { return iconStats; }
+
+  // Default 1 MB, a few hundred Material icons.
+  static void SetDocumentBudget(size_t bytes);
+  static size_t GetDocumentBudget() { return documentBudget; }
+  static void ClearDocuments();
+  static const SvgDocumentStats &GetDocumentStats() {
+    return documents.GetStats();
+  }
+
+  // Off by default. Always off without RAYM3_ASYNC_ICONS.
+  static void SetAsyncIcons(bool enabled);
+  static bool IsAsyncIconsEnabled();
+  // Default 2 ms of atlas uploads per BeginFrame().
+  static void SetUploadBudget(double ms) { uploadBudgetMs = ms; }
+  static double GetUploadBudget() { return uploadBudgetMs; }
+  // Blocks until queued icons are rasterized, then uploads them all.
+  static void WaitForPendingIcons();
+  static int GetPendingIcons();
+  // Queued icons the workers have not finished; they are uploaded later.
+  static int GetRasterizingIcons();
+
+  // Makes sure icon is cached at width x height (or as a distance field in
+  // SDF mode).
+  // With RAYM3_ASYNC_ICONS it is queued on the workers whatever
+  // SetAsyncIcons() says; otherwise it is rasterized now. Returns whether it
+  // was queued on the workers, like FontManager::Prewarm(); false if it was
+  // rasterized now, already cached, pending or missing.
+  static bool Prewarm(IconHandle icon, float width, float height);
+  static bool Prewarm(IconHandle icon, float size) {
+    return Prewarm(icon, size, size);
+  }
+
 private:
+  struct CachedIcon {
+    IconSlot slot;
+    uint64_t lastUsed; // Frame number
+  };
+  // Handle id in the high 32 bits, then 16 bits each of width and height;
+  // 0x0 is the icon's distance field.
+  using IconCache = std::unordered_map<uint64_t, CachedIcon>;
+
+  struct IconName {
+    std::string name;
+    IconVariation variation;
+    bool missing; // SVG not found; not looked up again
+  };
+
+  // Lets the name maps be searched with a string_view, without a copy.
+  struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const {
+      return std::hash<std::string_view>{}(name);
+    }
+  };
+  using NameMap =
+      std::unordered_map<std::string, int, NameHash, std::equal_to<>>;
+
+  struct DocumentEntry {
+    std::shared_ptr<SvgModel> model;
+    size_t bytes;
+  };
+
+  struct IconJob {
+    uint64_t sequence; // Request order
+    uint64_t key;
+    int icon; // Handle id
+    std::string name;
+    IconVariation variation;
+    int width;
+    int height;
+    bool sdf;
+    std::string base; // Resolved on the main thread
+  };
+
+  struct IconResult {
+    uint64_t sequence;
+    uint64_t key;
+    int icon;
+    int width;
+    int height;
+    std::vector<unsigned char> pixels; // Gray-alpha, empty on failure
+    bool found;                        // False if the SVG does not exist
+  };
+
   static std::string basePath;
-  static std::unordered_map<std::string, Texture2D> textureCache;
+  static std::vector<IconName> iconNames; // Indexed by handle id
+  static NameMap iconIds[5];               // Per IconVariation
+  static IconCache iconCache;
+  static uint64_t frameCount;
+  static size_t iconBudget;
+  static bool sizeBuckets;
+  static bool sdfEnabled;
+  static SvgIconCacheStats iconStats;
+  // Keyed by "folder/name".
+  static LruCache<std::string, DocumentEntry, std::hash<std::string>,
+                  SvgDocumentStats>
+      documents;
+  static size_t documentBudget;
+  static std::mutex documentMutex; // Workers share the document cache
+  static std::vector<NSVGrasterizer *> rasterizers;
+  static std::mutex rasterizerMutex;
   static bool autoDetected;
 
-  static std::string GetCacheKey(const char *name, IconVariation variation,
-                                 int width, int height);
-  static Texture2D LoadSvgTexture(const char *name, IconVariation variation,
-                                  int width, int height);
+  // Main thread only.
+  static std::unordered_set<uint64_t> pendingIcons; // Cache keys
+  static bool asyncIcons;
+  static double uploadBudgetMs;
+  static std::vector<std::thread> workers;
+  static uint64_t nextSequence;
+  static uint64_t nextUpload; // Sequence of the next icon to upload
+  // Results finished ahead of an earlier request, by sequence.
+  static std::map<uint64_t, IconResult> heldResults;
+
+  // Guarded by jobMutex.
+  static std::mutex jobMutex;
+  static std::condition_variable jobReady;
+  static std::condition_variable jobsDone;
+  static std::deque<IconJob> jobs;
+  static std::vector<IconResult> finished; // In completion order
+  static int jobsInFlight; // Queued or being rasterized
+  static bool stopWorkers;
+
+  static uint64_t IconKey(IconHandle icon, int width, int height) {
+    return (uint64_t)icon.id << 32 | (uint64_t)width << 16 | (uint64_t)height;
+  }
+  static void ClearMissing();
+  static IconCache::iterator CacheIcon(uint64_t key, const IconSlot &slot);
+  static void EvictIcons();
+  // Searched for the icons directory only if the pack lacks the icon.
+  static const std::string &GetBasePath(const char *name,
+                                        IconVariation variation);
+  static void OpenDefaultPack();
+  static std::shared_ptr<SvgModel> ParseDocument(const char *name,
+                                                IconVariation variation,
+                                                const std::string &base);
+  static std::shared_ptr<const SvgModel>
+  GetDocument(const char *name, IconVariation variation,
+              const std::string &base);
+  // Evicts the oldest documents while over budget, keeping at least keep.
+  // Caller holds documentMutex.
+  static void EvictDocuments(size_t keep);
+  static NSVGrasterizer *AcquireRasterizer();
+  static void ReleaseRasterizer(NSVGrasterizer *rast);
+  // Thread-safe. White gray-alpha with the SVG's coverage as alpha, fitted
+  // to width x height inside a transparent border of padding texels.
+  static bool RasterizeIcon(const SvgModel &model, int width, int height,
+                            std::vector<unsigned char> *grayAlpha,
+                            int padding = 0);
+  // Thread-safe. White gray-alpha with the signed distance to the SVG's edge
+  // as alpha, encoded like raylib's FONT_SDF glyphs, at the reference size.
+  static bool RasterizeDistanceField(const SvgModel &model,
+                                     std::vector<unsigned char> *grayAlpha);
+  // width and height are ignored for a distance field.
+  static bool LoadSvgIcon(IconHandle icon, int width, int height, bool sdf,
+                          IconSlot *slot);
+  static void QueueIcon(uint64_t key, IconHandle icon, int width, int height,
+                        bool sdf);
+  static void WorkerLoop();
+  static void StopWorkers();
+  static void UploadFinished(bool budgeted);
 };
 
 } // namespace raym3
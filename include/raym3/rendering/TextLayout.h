@@ -0,0 +1,108 @@
+#pragma once
+
+#include "raym3/rendering/LruCache.h"
+#include "raym3/types.h"
+#include <cstdint>
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+namespace raym3 {
+
+struct TextLayoutStyle {
+  float fontSize = 14.0f;
+  FontWeight weight = FontWeight::Regular;
+  float maxWidth = 0.0f; // Wrap width; 0 breaks only at '\n'
+  int maxLines = 0;      // 0 for no limit
+  TextAlignment alignment = TextAlignment::Left;
+  bool ellipsis = true;  // End text cut off by maxLines with "..."
+  float lineHeight = 0.0f; // 0 uses fontSize * 20 / 14 (MD3 body text)
+};
+
+struct TextLayoutLine {
+  std::string text; // Including the ellipsis, if any
+  float x;          // Offset for the alignment
+  float width;
+};
+
+struct TextLayoutResult {
+  std::vector<TextLayoutLine> lines;
+  Vector2 size;     // Widest line by lines * lineHeight
+  float fontSize;
+  FontWeight weight;
+  float lineHeight;
+  bool truncated;   // maxLines cut the text short
+};
+
+using TextLayoutStats = LruCacheStats;
+
+// Breaks UTF-8 text into lines for a width and style: greedy at spaces,
+// mid-word for words wider than a line, and always at '\n'. Lines are
+// aligned within maxWidth (or the widest line when not wrapping).
+//
+// Layouts are memoized by (font, text hash, style) and the least recently
+// used beyond GetCapacity() are evicted, so a paragraph that does not change
+// is broken once rather than every frame. A returned layout stays valid
+// until it is evicted or the cache is cleared; use it within the frame.
+class TextLayout {
+public:
+  // textHash may be a precomputed TextMeasureCache::Hash(text); 0 hashes
+  // text.
+  static const TextLayoutResult &Get(const char *text,
+                                     const TextLayoutStyle &style,
+                                     uint64_t textHash = 0);
+  // Size of Get(text, style).
+  static Vector2 Measure(const char *text, const TextLayoutStyle &style,
+                         uint64_t textHash = 0);
+  // Draws the lines with their top-left at position. Each line is one
+  // glyph run, centered vertically in its line height.
+  static void Draw(const TextLayoutResult &layout, Vector2 position,
+                   Color color);
+
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled() { return enabled_; }
+  static void SetCapacity(int maxEntries);
+  static int GetCapacity() { return capacity_; }
+  // Called when fonts change, as for TextMeasureCache.
+  static void Clear();
+
+  static const TextLayoutStats &GetStats() { return cache_.GetStats(); }
+  static void ResetStats() { cache_.ResetStats(); }
+
+private:
+  struct Key {
+    uint64_t font; // FontManager::GetFontId()
+    uint64_t text;
+    float fontSize;
+    float maxWidth;
+    float lineHeight;
+    int maxLines;
+    FontWeight weight;
+    TextAlignment alignment;
+    bool ellipsis;
+
+    bool operator==(const Key &other) const {
+      return font == other.font && text == other.text &&
+             fontSize == other.fontSize && maxWidth == other.maxWidth &&
+             lineHeight == other.lineHeight && maxLines == other.maxLines &&
+             weight == other.weight && alignment == other.alignment &&
+             ellipsis == other.ellipsis;
+    }
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const;
+  };
+
+  static void Build(const char *text, const TextLayoutStyle &style,
+                    Font font, TextLayoutResult *layout);
+
+  static bool enabled_;
+  static int capacity_;
+  static LruCache<Key, TextLayoutResult, KeyHash> cache_;
+  // Result of the last Get() that was not cached: caching disabled, or a
+  // stand-in font while glyphs rasterize in the background.
+  static TextLayoutResult scratch_;
+};
+
+} // namespace raym3
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "raym3/rendering/LruCache.h"
+#include <cstdint>
+#include <raylib.h>
+
+namespace raym3 {
+
+using TextMeasureCacheStats = LruCacheStats;
+
+// Memoized MeasureTextEx results keyed by (font, text hash, size, spacing).
+// Widgets measure the same static labels every frame, so after the first
+// frame measuring one is a hash of the string and a table lookup. Holds at
+// most GetCapacity() sizes and evicts the least recently used.
+//
+// Callers with stable labels can hash them once with Hash() and pass the
+// value to Renderer::MeasureText/MeasureTextEx to skip hashing too. The hash
+// must be of exactly the text being measured.
+class TextMeasureCache {
+public:
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled() { return enabled_; }
+
+  static void SetCapacity(int maxEntries);
+  static int GetCapacity() { return capacity_; }
+
+  // Never returns 0, which Renderer takes as "not precomputed".
+  static uint64_t Hash(const char *text);
+
+  // fontId is FontManager::GetFontId().
+  static bool Lookup(uint64_t fontId, uint64_t textHash, float fontSize,
+                     float spacing, Vector2 *size);
+  static void Store(uint64_t fontId, uint64_t textHash, float fontSize,
+                    float spacing, Vector2 size);
+
+  // Called when a font is unloaded, since a font FontManager did not create
+  // is identified by its address, which a new font may reuse.
+  static void Clear();
+
+  static const TextMeasureCacheStats &GetStats() { return cache_.GetStats(); }
+  static void ResetStats() { cache_.ResetStats(); }
+
+private:
+  struct Key {
+    uint64_t font;
+    uint64_t text;
+    float fontSize;
+    float spacing;
+
+    bool operator==(const Key &other) const {
+      return font == other.font && text == other.text &&
+             fontSize == other.fontSize && spacing == other.spacing;
+    }
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const;
+  };
+
+  static bool enabled_;
+  static int capacity_;
+  static LruCache<Key, Vector2, KeyHash> cache_;
+};
+
+} // namespace raym3
@@ -82,8 +82,8 @@ bool CheckboxComponent::Render(const char *label, Rectangle bounds,
     p2 = {center.x - 1.0f, center.y + 2.5f};
     p3 = {center.x + 3.5f, center.y - 3.0f};
 
-    DrawLineEx(p1, p2, thickness, scheme.onPrimary);
-    DrawLineEx(p2, p3, thickness, scheme.onPrimary);
+    Renderer::DrawLine(p1, p2, thickness, scheme.onPrimary);
+    Renderer::DrawLine(p2, p3, thickness, scheme.onPrimary);
   } else {
     // Outline
     // MD3 Unchecked: onSurfaceVariant border
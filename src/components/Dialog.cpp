@@ -2,7 +2,9 @@
 #include "raym3/components/Button.h"
 #include "raym3/layout/Layout.h"
 #include "raym3/raym3.h"
+#include "raym3/rendering/RenderBackend.h"
 #include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/TextLayout.h"
 #include "raym3/styles/Theme.h"
 #include <cstring>
 #include <raylib.h>
@@ -39,8 +41,7 @@ bool DialogComponent::Render(const char *title, const char *message,
 
 #if RAYM3_USE_INPUT_LAYERS
   InputLayerManager::PushLayer(9999);
-  Rectangle screenBounds = {0, 0, (float)GetScreenWidth(),
-                            (float)GetScreenHeight()};
+  Rectangle screenBounds = RenderBackend::GetScreenBounds();
   InputLayerManager::RegisterBlockingRegion(screenBounds, true);
   DrawBackdrop();
 #else
@@ -62,27 +63,18 @@ bool DialogComponent::Render(const char *title, const char *message,
   }
 
   float messageHeight = 0;
+  TextLayoutStyle messageStyle; // Body Medium
   if (message) {
-    // Simple approximation for wrapping text height or just single line for now
-    // For a proper implementation we'd need a multi-line text measure function
-    // extending the width if too wide, or wrapping.
-    // Keeping it simple: Extend width up to a max, then wrap height
-    Vector2 msgSize =
-        Renderer::MeasureText(message, 14.0f, FontWeight::Regular);
+    // Extend width up to a max for the longest line, then wrap at it
     float maxWidth = 560.0f;
-
-    if (width < msgSize.x + padding * 2) {
-      width = msgSize.x + padding * 2;
+    float lineWidth = TextLayout::Measure(message, messageStyle).x;
+    if (width < lineWidth + padding * 2) {
+      width = lineWidth + padding * 2;
       if (width > maxWidth)
         width = maxWidth;
     }
-
-    // Rough height estimation assuming wrapping
-    float textWidth = width - padding * 2;
-    float lines = std::ceil(msgSize.x / textWidth);
-    if (lines < 1)
-      lines = 1;
-    messageHeight = lines * 20.0f; // Line height 20
+    messageStyle.maxWidth = width - padding * 2;
+    messageHeight = TextLayout::Measure(message, messageStyle).y;
   }
 
   float buttonAreaHeight = (buttons && buttonCount_ > 0) ? 52.0f : 0.0f;
@@ -93,7 +85,7 @@ bool DialogComponent::Render(const char *title, const char *message,
     height -= padding; // Button area includes bottom padding usually
 
   // Center on screen
-  Rectangle screen = {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()};
+  Rectangle screen = RenderBackend::GetScreenBounds();
   Rectangle dialogBounds = {screen.x + (screen.width - width) / 2.0f,
                             screen.y + (screen.height - height) / 2.0f, width,
                             height};
@@ -130,9 +122,8 @@ bool DialogComponent::Render(const char *title, const char *message,
     Rectangle textBounds = {dialogBounds.x + padding, y,
                             dialogBounds.width - padding * 2, messageHeight};
     Layout::RegisterDebugRect(textBounds);
-    Renderer::DrawText(message, {textBounds.x, textBounds.y}, 14.0f,
-                       scheme.onSurfaceVariant,
-                       FontWeight::Regular); // Body Medium
+    TextLayout::Draw(TextLayout::Get(message, messageStyle),
+                     {textBounds.x, textBounds.y}, scheme.onSurfaceVariant);
   }
 
   // Buttons (Actions)
@@ -200,12 +191,12 @@ bool DialogComponent::Render(const char *title, const char *message,
 }
 
 void DialogComponent::DrawBackdrop() {
-  int screenWidth = GetScreenWidth();
-  int screenHeight = GetScreenHeight();
+  int screenWidth = RenderBackend::Get()->GetScreenWidth();
+  int screenHeight = RenderBackend::Get()->GetScreenHeight();
   Rectangle backdrop = {0, 0, (float)screenWidth, (float)screenHeight};
   ColorScheme &scheme = Theme::GetColorScheme();
   Color scrimColor = ColorAlpha(scheme.scrim, 0.32f); // MD3 opacity 0.32
-  DrawRectangleRec(backdrop, scrimColor);
+  Renderer::DrawRectangle(backdrop, scrimColor);
 }
 
 int DialogComponent::GetSelectedButtonIndex() { return selectedButton_; }
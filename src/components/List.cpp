@@ -3,6 +3,7 @@
 #include "raym3/components/Tooltip.h"
 #include "raym3/layout/Layout.h"
 #include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/TextLayout.h"
 #include "raym3/rendering/SvgRenderer.h"
 #include "raym3/styles/Theme.h"
 #include <raylib.h>
@@ -125,7 +126,7 @@ static float RenderListItems(Rectangle bounds, ListItem *items, int itemCount,
       
       if (isDragSource) {
         // Draw semi-transparent version
-        DrawRectangleRec(itemBounds, ColorAlpha(scheme.surfaceContainerHigh, 0.5f));
+        Renderer::DrawRectangle(itemBounds, ColorAlpha(scheme.surfaceContainerHigh, 0.5f));
       } else {
         if (item.selected) {
           Renderer::DrawRoundedRectangle(itemBounds,
@@ -177,9 +178,17 @@ static float RenderListItems(Rectangle bounds, ListItem *items, int itemCount,
       }
 
       if (item.text) {
-        Vector2 textPos = {contentX, centerY - 7.0f};
-        Renderer::DrawText(item.text, textPos, 14.0f, contentColor,
-                           FontWeight::Regular);
+        // One line, cut with "..." before the trailing action
+        bool hasTrailing = item.secondaryActionIcon || item.childCount > 0;
+        TextLayoutStyle textStyle;
+        textStyle.maxLines = 1;
+        textStyle.maxWidth =
+            std::max(1.0f, itemBounds.x + itemBounds.width - contentX -
+                               (hasTrailing ? 48.0f : basePadding));
+        const TextLayoutResult &textLayout =
+            TextLayout::Get(item.text, textStyle);
+        Vector2 textPos = {contentX, centerY - textLayout.size.y / 2.0f};
+        TextLayout::Draw(textLayout, textPos, contentColor);
       }
 
       if (item.secondaryActionIcon || (item.childCount > 0)) {
@@ -502,7 +511,9 @@ void List(Rectangle bounds, ListItem *items, int itemCount, float *outHeight,
       lineY = itemBounds.back().y + itemBounds.back().height;
     }
     
-    DrawRectangle((int)bounds.x, (int)lineY - 2, (int)bounds.width, 4, scheme.primary);
+    Renderer::DrawRectangle({(float)(int)bounds.x, (float)((int)lineY - 2),
+                             (float)(int)bounds.width, 4.0f},
+                            scheme.primary);
     
     // Handle drop
     if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
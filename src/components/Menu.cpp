@@ -214,7 +214,7 @@ void MenuComponent::Render(Rectangle bounds, const MenuItem *items,
       // Draw Divider
       float dividerY = currentY + 8.0f; // Center in padding
       Rectangle dividerBounds = {bounds.x, dividerY, bounds.width, 1.0f};
-      DrawLineEx({dividerBounds.x, dividerBounds.y},
+      Renderer::DrawLine({dividerBounds.x, dividerBounds.y},
                  {dividerBounds.x + dividerBounds.width, dividerBounds.y}, 1.0f,
                  scheme.outlineVariant);
       currentY += 17.0f; // 1px + 16px padding
@@ -282,8 +282,8 @@ void MenuComponent::Render(Rectangle bounds, const MenuItem *items,
 
     // Trailing Text / Icon
     if (items[i].trailingText) {
-      Vector2 textSize =
-          MeasureTextEx(GetFontDefault(), items[i].trailingText, 14.0f, 1.0f);
+      Vector2 textSize = Renderer::MeasureTextEx(
+          GetFontDefault(), items[i].trailingText, 14.0f, 1.0f);
       Vector2 textPos = {itemBounds.x + itemBounds.width - textSize.x - 12.0f,
                          centerY - 7.0f};
       Renderer::DrawText(items[i].trailingText, textPos, 14.0f, textColor,
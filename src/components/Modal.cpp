@@ -6,6 +6,7 @@
 #include "raym3/components/TextField.h"
 #include "raym3/components/Tooltip.h"
 #include "raym3/layout/Layout.h"
+#include "raym3/rendering/RenderBackend.h"
 #include "raym3/rendering/Renderer.h"
 #include "raym3/styles/Theme.h"
 #include <cstring>
@@ -31,15 +32,14 @@ Rectangle ModalComponent::Begin(const char *title, const char *message,
 
 #if RAYM3_USE_INPUT_LAYERS
   InputLayerManager::PushLayer(9999);
-  Rectangle screenBounds = {0, 0, (float)GetScreenWidth(),
-                            (float)GetScreenHeight()};
+  Rectangle screenBounds = RenderBackend::GetScreenBounds();
   InputLayerManager::RegisterBlockingRegion(screenBounds, true);
 #endif
 
   DrawBackdrop();
 
-  int screenWidth = GetScreenWidth();
-  int screenHeight = GetScreenHeight();
+  int screenWidth = RenderBackend::Get()->GetScreenWidth();
+  int screenHeight = RenderBackend::Get()->GetScreenHeight();
 
   // Calculate bounds centered
   s_currentModalBounds = {(screenWidth - width) / 2.0f,
@@ -214,11 +214,10 @@ bool ModalComponent::Render(const char *title, const char *message,
 }
 
 void ModalComponent::DrawBackdrop() {
-  Rectangle backdrop = {0, 0, (float)GetScreenWidth(),
-                        (float)GetScreenHeight()};
+  Rectangle backdrop = RenderBackend::GetScreenBounds();
   ColorScheme &scheme = Theme::GetColorScheme();
   Color scrimColor = ColorAlpha(scheme.scrim, 0.32f);
-  DrawRectangleRec(backdrop, scrimColor);
+  Renderer::DrawRectangle(backdrop, scrimColor);
 }
 
 Rectangle ModalComponent::GetModalBounds() {
@@ -50,9 +50,9 @@ static void DrawWigglyLine(Vector2 start, Vector2 end, float amplitude,
 
   // If amplitude is tiny, just draw a straight line
   if (amplitude < 0.01f) {
-    DrawLineEx(start, end, thick, color);
-    DrawCircleV(start, thick / 2.0f, color);
-    DrawCircleV(end, thick / 2.0f, color);
+    Renderer::DrawLine(start, end, thick, color);
+    Renderer::DrawCircle(start, thick / 2.0f, color);
+    Renderer::DrawCircle(end, thick / 2.0f, color);
     return;
   }
 
@@ -76,8 +76,8 @@ static void DrawWigglyLine(Vector2 start, Vector2 end, float amplitude,
     Vector2 center = Vector2Add(Vector2Add(start, Vector2Scale(dir, dist)),
                                 Vector2Scale(normal, offset));
 
-    DrawLineEx(prevPos, center, thick, color);
-    DrawCircleV(center, thick / 2.0f, color); // Smooth joins
+    Renderer::DrawLine(prevPos, center, thick, color);
+    Renderer::DrawCircle(center, thick / 2.0f, color); // Smooth joins
     prevPos = center;
   }
 }
@@ -99,7 +99,7 @@ static void DrawWigglyArc(Vector2 center, float radius, float startAngle,
 
   // If amplitude is tiny, draw a normal ring arc (approximated)
   if (amplitude < 0.01f) {
-    DrawRing(center, radius - thick / 2.0f, radius + thick / 2.0f, startAngle,
+    Renderer::DrawRing(center, radius - thick / 2.0f, radius + thick / 2.0f, startAngle,
              endAngle, 0, color);
     // Caps are tricky with DrawRing, but let's stick to the wiggly path for
     // consistency if needed, or just assume standard drawing is better.
@@ -137,8 +137,8 @@ static void DrawWigglyArc(Vector2 center, float radius, float startAngle,
     Vector2 currentPos = {x, y};
 
     if (!first) {
-      DrawLineEx(prevPos, currentPos, thick, color);
-      DrawCircleV(currentPos, thick / 2.0f, color); // Smooth joins
+      Renderer::DrawLine(prevPos, currentPos, thick, color);
+      Renderer::DrawCircle(currentPos, thick / 2.0f, color); // Smooth joins
     } else {
       first = false;
     }
@@ -174,7 +174,7 @@ void ProgressIndicator::Circular(Rectangle bounds, float value,
   Color trackColor = scheme.surfaceContainerHighest;
   // Use a high segment count for a smooth circle (e.g., 60-120 depending on
   // size) Let's use 128 to be safe and smooth
-  DrawRing(center, radius - thickness / 2.0f, radius + thickness / 2.0f, 0.0f,
+  Renderer::DrawRing(center, radius - thickness / 2.0f, radius + thickness / 2.0f, 0.0f,
            360.0f, 128, trackColor);
 
   float phase = (float)GetTime() * 10.0f; // Animated wiggle
@@ -126,15 +126,15 @@ bool RadioButtonComponent::Render(const char *label, Rectangle bounds,
     // Selected: Outer stroke 2dp Primary. Inner dot 10dp Primary.
     // Unselected: Outer stroke 2dp OnSurfaceVariant. No inner dot.
 
-    DrawRing(center, outerRadius - strokeWidth, outerRadius, 0, 360, 32,
+    Renderer::DrawRing(center, outerRadius - strokeWidth, outerRadius, 0, 360, 32,
              outerColor);
 
     // Inner dot
     float dotRadius = 5.0f; // 10dp diameter
-    DrawCircleV(center, dotRadius, innerColor);
+    Renderer::DrawCircle(center, dotRadius, innerColor);
   } else {
     // Unselected
-    DrawRing(center, outerRadius - strokeWidth, outerRadius, 0, 360, 32,
+    Renderer::DrawRing(center, outerRadius - strokeWidth, outerRadius, 0, 360, 32,
              outerColor);
   }
 
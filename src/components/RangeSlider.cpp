@@ -317,12 +317,12 @@ RangeSliderComponent::Render(Rectangle bounds, const std::vector<float> &values,
 
     if (minNorm > 0.02f) {
       Vector2 startDotPos = {trackBounds.x + stopInset, centerY};
-      DrawCircleV(startDotPos, stopDotRadius, activeColor);
+      Renderer::DrawCircle(startDotPos, stopDotRadius, activeColor);
     }
     if (maxNorm < 0.98f) {
       Vector2 endDotPos = {trackBounds.x + trackBounds.width - stopInset,
                            centerY};
-      DrawCircleV(endDotPos, stopDotRadius, inactiveColor);
+      Renderer::DrawCircle(endDotPos, stopDotRadius, inactiveColor);
     }
   }
 
@@ -355,7 +355,7 @@ RangeSliderComponent::Render(Rectangle bounds, const std::vector<float> &values,
                             tickNorm <= normalizedValues[result.size() - 1])
                          : (tickNorm < normalizedValues[0]);
       Color tickColor = inRange ? scheme.onPrimary : activeColor;
-      DrawCircleV(tickPos, tickRadius, tickColor);
+      Renderer::DrawCircle(tickPos, tickRadius, tickColor);
     }
   }
 
@@ -367,7 +367,7 @@ RangeSliderComponent::Render(Rectangle bounds, const std::vector<float> &values,
     // Gap Mask
     Rectangle maskRect = {thumbRect.x - gapSize, thumbRect.y,
                           thumbRect.width + (gapSize * 2), thumbRect.height};
-    DrawRectangleRec(maskRect, scheme.surface);
+    Renderer::DrawRectangle(maskRect, scheme.surface);
 
     // Thumb
     Renderer::DrawRoundedRectangle(thumbRect, thumbWidth / 2.0f, handleColor);
@@ -401,8 +401,8 @@ RangeSliderComponent::Render(Rectangle bounds, const std::vector<float> &values,
                   bubbleRect.y + bubbleRect.height};
     Vector2 p3 = {bubbleRect.x + bubbleRect.width / 2.0f,
                   bubbleRect.y + bubbleRect.height + triangleHeight};
-    DrawTriangle(p1, p2, p3, bubbleColor);
-    DrawTriangle(p1, p3, p2, bubbleColor);
+    Renderer::DrawTriangle(p1, p2, p3, bubbleColor);
+    Renderer::DrawTriangle(p1, p3, p2, bubbleColor);
 
     Vector2 textSize =
         Renderer::MeasureText(valueStr, 14.0f, FontWeight::Medium);
@@ -427,7 +427,7 @@ RangeSliderComponent::Render(Rectangle bounds, const std::vector<float> &values,
       float focusInset = -4.0f;
       Rectangle focusRect = {focusThumb.x + focusInset, focusThumb.y + focusInset,
                              focusThumb.width - focusInset * 2, focusThumb.height - focusInset * 2};
-      DrawRectangleLinesEx(focusRect, 2.0f, ColorAlpha(scheme.primary, 0.5f));
+      Renderer::DrawRectangleLines(focusRect, 2.0f, ColorAlpha(scheme.primary, 0.5f));
     }
   }
   
@@ -86,26 +86,26 @@ bool SegmentedButtonComponent::Render(Rectangle bounds,
         Rectangle rightRect = {r.x + cornerRadius, r.y, r.width - cornerRadius,
                                r.height};
         if (rightRect.width > 0)
-          DrawRectangleRec(rightRect, c);
+          Renderer::DrawRectangle(rightRect, c);
 
         // Draw left semi-circle
         // Raylib angles: 90=Down, 180=Left, 270=Up
         Vector2 center = {r.x + cornerRadius, r.y + cornerRadius};
-        DrawCircleSector(center, cornerRadius, 90, 270, 24, c);
+        Renderer::DrawCircleSector(center, cornerRadius, 90, 270, 24, c);
       } else if (i == itemCount - 1) {
         // Last item: Left square, Right rounded
         // Draw rect on left (non-overlapping)
         Rectangle leftRect = {r.x, r.y, r.width - cornerRadius, r.height};
         if (leftRect.width > 0)
-          DrawRectangleRec(leftRect, c);
+          Renderer::DrawRectangle(leftRect, c);
 
         // Draw right semi-circle
         // Raylib angles: 270=Up, 360=Right, 450=Down
         Vector2 center = {r.x + r.width - cornerRadius, r.y + cornerRadius};
-        DrawCircleSector(center, cornerRadius, 270, 450, 24, c);
+        Renderer::DrawCircleSector(center, cornerRadius, 270, 450, 24, c);
       } else {
         // Middle item: Square
-        DrawRectangleRec(r, c);
+        Renderer::DrawRectangle(r, c);
       }
     };
 
@@ -143,7 +143,7 @@ bool SegmentedButtonComponent::Render(Rectangle bounds,
       float gap = 8.0f;
       // Measure text
       Font font = Theme::GetFont(14, FontWeight::Medium);
-      Vector2 textSize = MeasureTextEx(font, label, 14, 1.0f);
+      Vector2 textSize = Renderer::MeasureTextEx(font, label, 14, 1.0f);
       float totalWidth = iconSize + gap + textSize.x;
 
       float startX = contentX - totalWidth / 2.0f;
@@ -154,7 +154,7 @@ bool SegmentedButtonComponent::Render(Rectangle bounds,
                             contentColor);
 
       Vector2 textPos = {startX + iconSize + gap, contentY - textSize.y / 2.0f};
-      DrawTextEx(font, label, textPos, 14, 1.0f, contentColor);
+      Renderer::DrawTextEx(font, label, textPos, 14, 1.0f, contentColor);
 
     } else if (iconName) {
       // Icon Only
@@ -166,10 +166,10 @@ bool SegmentedButtonComponent::Render(Rectangle bounds,
     } else if (label) {
       // Text Only
       Font font = Theme::GetFont(14, FontWeight::Medium);
-      Vector2 textSize = MeasureTextEx(font, label, 14, 1.0f);
+      Vector2 textSize = Renderer::MeasureTextEx(font, label, 14, 1.0f);
       Vector2 textPos = {contentX - textSize.x / 2.0f,
                          contentY - textSize.y / 2.0f};
-      DrawTextEx(font, label, textPos, 14, 1.0f, contentColor);
+      Renderer::DrawTextEx(font, label, textPos, 14, 1.0f, contentColor);
     }
 
     // Input
@@ -198,7 +198,7 @@ bool SegmentedButtonComponent::Render(Rectangle bounds,
   // Draw Dividers
   for (int i = 1; i < itemCount; ++i) {
     float x = bounds.x + i * segmentWidth;
-    DrawLineEx({x, bounds.y}, {x, bounds.y + bounds.height}, 1.0f,
+    Renderer::DrawLine({x, bounds.y}, {x, bounds.y + bounds.height}, 1.0f,
                scheme.outline);
   }
 
@@ -345,7 +345,7 @@ float SliderComponent::Render(Rectangle bounds, float value, float min,
     // Dot color should be activeColor? Or onSurfaceVariant?
     // If track is filled up to there (1.0), it's on active. But at 1.0 thumb
     // covers it. Usually it's on the inactive part.
-    DrawCircleV(dotPos, dotRadius, activeColor);
+    Renderer::DrawCircle(dotPos, dotRadius, activeColor);
   }
 
   // Draw Stop Indicators at min/max (M3 feature)
@@ -356,13 +356,13 @@ float SliderComponent::Render(Rectangle bounds, float value, float min,
     if (normalizedValue > 0.02f) { // Only show if thumb isn't covering it
       Vector2 startDotPos = {trackBounds.x + stopInset,
                              trackBounds.y + trackHeight / 2.0f};
-      DrawCircleV(startDotPos, stopDotRadius, activeColor);
+      Renderer::DrawCircle(startDotPos, stopDotRadius, activeColor);
     }
     // End stop (at max)
     if (normalizedValue < 0.98f) { // Only show if thumb isn't covering it
       Vector2 endDotPos = {trackBounds.x + trackBounds.width - stopInset,
                            trackBounds.y + trackHeight / 2.0f};
-      DrawCircleV(endDotPos, stopDotRadius, inactiveColor);
+      Renderer::DrawCircle(endDotPos, stopDotRadius, inactiveColor);
     }
   }
 
@@ -381,7 +381,7 @@ float SliderComponent::Render(Rectangle bounds, float value, float min,
       Vector2 tickPos = {tickX, trackBounds.y + trackHeight / 2.0f};
       Color tickColor =
           (tickNorm < normalizedValue) ? scheme.onPrimary : activeColor;
-      DrawCircleV(tickPos, tickRadius, tickColor);
+      Renderer::DrawCircle(tickPos, tickRadius, tickColor);
     }
   }
 
@@ -390,7 +390,7 @@ float SliderComponent::Render(Rectangle bounds, float value, float min,
   Rectangle maskRect = {thumbRect.x - gapSize,
                         thumbRect.y, // Match thumb y
                         thumbRect.width + (gapSize * 2), thumbRect.height};
-  DrawRectangleRec(maskRect, scheme.surface);
+  Renderer::DrawRectangle(maskRect, scheme.surface);
 
   // Draw Handle (Thumb)
   Renderer::DrawRoundedRectangle(thumbRect, thumbWidth / 2.0f, handleColor);
@@ -426,11 +426,11 @@ float SliderComponent::Render(Rectangle bounds, float value, float min,
                   bubbleRect.y + bubbleRect.height};
     Vector2 p3 = {bubbleRect.x + bubbleRect.width / 2.0f,
                   bubbleRect.y + bubbleRect.height + triangleHeight};
-    DrawTriangle(p1, p2, p3, bubbleColor); // Note: Raylib DrawTriangle order
-                                           // might matter for culling
+    // Note: Raylib DrawTriangle order might matter for culling
+    Renderer::DrawTriangle(p1, p2, p3, bubbleColor);
     // Actually DrawTriangle draws counter-clockwise by default? Or clockwise?
     // Let's ensure it draws.
-    DrawTriangle(p1, p3, p2, bubbleColor);
+    Renderer::DrawTriangle(p1, p3, p2, bubbleColor);
 
     // Draw Value
     Vector2 textSize =
@@ -452,7 +452,7 @@ float SliderComponent::Render(Rectangle bounds, float value, float min,
     float focusInset = -4.0f;
     Rectangle focusRect = {thumbRect.x + focusInset, thumbRect.y + focusInset,
                            thumbRect.width - focusInset * 2, thumbRect.height - focusInset * 2};
-    DrawRectangleLinesEx(focusRect, 2.0f, ColorAlpha(scheme.primary, 0.5f));
+    Renderer::DrawRectangleLines(focusRect, 2.0f, ColorAlpha(scheme.primary, 0.5f));
   }
   
   // Tooltip support
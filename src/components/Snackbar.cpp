@@ -1,7 +1,9 @@
 #include "raym3/components/Snackbar.h"
 #include "raym3/layout/Layout.h"
 #include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/TextLayout.h"
 #include "raym3/styles/Theme.h"
+#include <algorithm>
 #include <raylib.h>
 
 #if RAYM3_USE_INPUT_LAYERS
@@ -74,16 +76,22 @@ void SnackbarComponent::Render(Rectangle screenBounds) {
   Renderer::DrawElevatedRectangle(bounds, cornerRadius, 3,
                                   scheme.inverseSurface);
 
-  // Text - Inverse On Surface
+  // Text - Inverse On Surface, one line ending in "..." if it does not fit
+  // beside the action
   float textPaddingX = 16.0f;
-  // Measure text to vertically center it exactly
-  Vector2 textSize =
-      Renderer::MeasureText(message_.c_str(), 14.0f, FontWeight::Regular);
+  TextLayoutStyle textStyle;
+  textStyle.maxLines = 1;
+  textStyle.maxWidth = bounds.width - textPaddingX * 2;
+  if (action_.label) {
+    Vector2 labelSize =
+        Renderer::MeasureText(action_.label, 14.0f, FontWeight::Medium);
+    textStyle.maxWidth -= labelSize.x + 12.0f * 2;
+  }
+  const TextLayoutResult &textLayout =
+      TextLayout::Get(message_.c_str(), textStyle);
   Vector2 textPos = {bounds.x + textPaddingX,
-                     bounds.y + (bounds.height - textSize.y) / 2.0f};
-
-  Renderer::DrawText(message_.c_str(), textPos, 14.0f, scheme.inverseOnSurface,
-                     FontWeight::Regular);
+                     bounds.y + (bounds.height - textLayout.size.y) / 2.0f};
+  TextLayout::Draw(textLayout, textPos, scheme.inverseOnSurface);
 
   // Action Button
   if (action_.label) {
@@ -117,7 +125,8 @@ void SnackbarComponent::Render(Rectangle screenBounds) {
       }
       // Draw Hover Overlay
       Color hoverColor = ColorAlpha(actionColor, 0.08f);
-      DrawRectangleRounded(btnBounds, 0.5f, 4, hoverColor);
+      Renderer::DrawRoundedRectangle(
+          btnBounds, std::min(btnBounds.width, btnBounds.height) * 0.25f, hoverColor);
     }
 #else
     if (isHovered) {
@@ -126,7 +135,8 @@ void SnackbarComponent::Render(Rectangle screenBounds) {
       }
       // Draw Hover Overlay
       Color hoverColor = ColorAlpha(actionColor, 0.08f);
-      DrawRectangleRounded(btnBounds, 0.5f, 4, hoverColor);
+      Renderer::DrawRoundedRectangle(
+          btnBounds, std::min(btnBounds.width, btnBounds.height) * 0.25f, hoverColor);
     }
 #endif
 
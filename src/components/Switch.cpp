@@ -171,8 +171,8 @@ bool SwitchComponent::Render(const char *label, Rectangle bounds,
     Vector2 p2 = {center.x - 1.0f * scale, center.y + 3.0f * scale};
     Vector2 p3 = {center.x + 5.0f * scale, center.y - 5.0f * scale};
 
-    DrawLineEx(p1, p2, 2.0f * scale, iconColor);
-    DrawLineEx(p2, p3, 2.0f * scale, iconColor);
+    Renderer::DrawLine(p1, p2, 2.0f * scale, iconColor);
+    Renderer::DrawLine(p2, p3, 2.0f * scale, iconColor);
   } else {
     // 'X' Icon
     float half = 4.0f * scale;
@@ -181,8 +181,8 @@ bool SwitchComponent::Render(const char *label, Rectangle bounds,
     Vector2 p3 = {center.x - half, center.y + half};
     Vector2 p4 = {center.x + half, center.y - half};
 
-    DrawLineEx(p1, p2, 2.0f * scale, iconColor);
-    DrawLineEx(p3, p4, 2.0f * scale, iconColor);
+    Renderer::DrawLine(p1, p2, 2.0f * scale, iconColor);
+    Renderer::DrawLine(p3, p4, 2.0f * scale, iconColor);
   }
 
   // Draw State Layer
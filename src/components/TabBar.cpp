@@ -3,6 +3,7 @@
 #include "raym3/raym3.h"
 #include "raym3/components/IconButton.h"
 #include "raym3/components/Tooltip.h"
+#include "raym3/rendering/RenderBackend.h"
 #include "raym3/rendering/Renderer.h"
 #include "raym3/styles/Theme.h"
 #include <algorithm>
@@ -208,14 +209,14 @@ int TabBarComponent::Render(Rectangle bounds, const std::vector<TabItem> &items,
       float topPadding = 5.0f;
 
       // PASS 1: Strip Background
-      DrawRectangleRec(bounds, inactiveTabColor);
+      Renderer::DrawRectangle(bounds, inactiveTabColor);
 
       // PASS 2: Inactive Tab Backgrounds/Hover (drawn BEFORE active tab flares)
       for (int i = 0; i < tabCount; i++) {
           if (i == selectedIndex) continue; // Skip active
           Rectangle tabBounds = {bounds.x + i * tabWidth, bounds.y, tabWidth, tabHeight};
           if (localHoveredTabIndex == i) {
-              DrawRectangleRec(tabBounds, ColorAlpha(scheme.onSurface, 0.08f));
+              Renderer::DrawRectangle(tabBounds, ColorAlpha(scheme.onSurface, 0.08f));
           }
       }
 
@@ -234,15 +235,15 @@ int TabBarComponent::Render(Rectangle bounds, const std::vector<TabItem> &items,
 
           // --- 1. Main body rectangles (Center & Sides) ---
           // Center vertical strip
-          DrawRectangleRec({x + r, y, w - 2*r, h}, activeTabColor);
+          Renderer::DrawRectangle({x + r, y, w - 2*r, h}, activeTabColor);
           // Left vertical strip (connected to top-left arch and bottom-left flare)
-          DrawRectangleRec({x, y + r, r, h - r + 0.5f}, activeTabColor);
+          Renderer::DrawRectangle({x, y + r, r, h - r + 0.5f}, activeTabColor);
           // Right vertical strip (connected to top-right arch and bottom-right flare)
-          DrawRectangleRec({x + w - r, y + r, r, h - r + 0.5f}, activeTabColor);
+          Renderer::DrawRectangle({x + w - r, y + r, r, h - r + 0.5f}, activeTabColor);
           
           // --- 2. Top Rounded Corners (Convex Arches) ---
-          DrawCircleSector({x + r, y + r}, r, 180, 270, 64, activeTabColor);
-          DrawCircleSector({x + w - r, y + r}, r, 270, 360, 64, activeTabColor);
+          Renderer::DrawCircleSector({x + r, y + r}, r, 180, 270, 64, activeTabColor);
+          Renderer::DrawCircleSector({x + w - r, y + r}, r, 270, 360, 64, activeTabColor);
           
           // --- 3. Bottom Flares (Concave Arches) ---
           Color leftMaskColor = inactiveTabColor;
@@ -257,13 +258,13 @@ int TabBarComponent::Render(Rectangle bounds, const std::vector<TabItem> &items,
 
           // Left Flare
           // Draw a slightly larger base rectangle to ensure no gaps with the body
-          DrawRectangleRec({x - r, y + h - r, r + 0.5f, r + 0.5f}, activeTabColor);
+          Renderer::DrawRectangle({x - r, y + h - r, r + 0.5f, r + 0.5f}, activeTabColor);
           // Draw the mask slightly larger to ensure it covers the edge completely
-          DrawCircleSector({x - r, y + h - r}, r + 0.5f, 0, 90, 64, leftMaskColor);
+          Renderer::DrawCircleSector({x - r, y + h - r}, r + 0.5f, 0, 90, 64, leftMaskColor);
           
           // Right Flare
-          DrawRectangleRec({x + w - 0.5f, y + h - r, r + 0.5f, r + 0.5f}, activeTabColor);
-          DrawCircleSector({x + w + r, y + h - r}, r + 0.5f, 90, 180, 64, rightMaskColor);
+          Renderer::DrawRectangle({x + w - 0.5f, y + h - r, r + 0.5f, r + 0.5f}, activeTabColor);
+          Renderer::DrawCircleSector({x + w + r, y + h - r}, r + 0.5f, 90, 180, 64, rightMaskColor);
       }
 
       // PASS 4: All Tab Content (Text, Icons, Close Buttons)
@@ -274,7 +275,7 @@ int TabBarComponent::Render(Rectangle bounds, const std::vector<TabItem> &items,
           
           // Dividers
           if (options.showDividers && i > 0 && !isActive && !prevIsActive) {
-              DrawLineEx({tabBounds.x, tabBounds.y + 7}, {tabBounds.x, tabBounds.y + tabHeight - 7}, 1.0f, dividerColor);
+              Renderer::DrawLine({tabBounds.x, tabBounds.y + 7}, {tabBounds.x, tabBounds.y + tabHeight - 7}, 1.0f, dividerColor);
           }
           
           Color textColor = isActive ? activeTextColor : inactiveTextColor;
@@ -326,7 +327,7 @@ void TabContentBegin(Rectangle bounds, Color backgroundColor, bool clip) {
   s_tabContentClipEnabled = clip && bounds.width > 0 && bounds.height > 0;
   
   // Draw background with top corners flat (matches tab bottom)
-  DrawRectangleRec(bounds, backgroundColor);
+  Renderer::DrawRectangle(bounds, backgroundColor);
   
   // Begin scissor for content clipping (optional)
   if (s_tabContentClipEnabled) {
@@ -345,7 +346,7 @@ Rectangle GetTabContentScissorBounds() {
   if (s_tabContentClipEnabled) {
     return s_tabContentBounds;
   }
-  return {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()};
+  return RenderBackend::GetScreenBounds();
 }
 
 //-----------------------------------------------------------------------------
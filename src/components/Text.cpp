@@ -1,5 +1,6 @@
 #include "raym3/components/Text.h"
 #include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/TextLayout.h"
 #include "raym3/styles/Theme.h"
 #include <algorithm>
 #include <cstring>
@@ -78,8 +79,35 @@ void TextComponent::Render(const char *text, Rectangle bounds, float fontSize,
 
     // Draw selection rect (using text height or bounds height? text lines
     // usually)
-    DrawRectangleRec({selX, position.y, selSize.x, textSize.y}, selColor);
+    Renderer::DrawRectangle({selX, position.y, selSize.x, textSize.y}, selColor);
   }
 }
 
+void TextComponent::RenderWrapped(const char *text, Rectangle bounds,
+                                  float fontSize, Color color,
+                                  FontWeight weight, TextAlignment alignment,
+                                  int maxLines) {
+  if (!text || text[0] == '\0')
+    return;
+
+  Color finalColor = color;
+  if (color.a == 0) {
+    finalColor = Theme::GetColorScheme().onSurface;
+  }
+
+  TextLayoutStyle style;
+  style.fontSize = fontSize;
+  style.weight = weight;
+  style.maxWidth = std::max(1.0f, bounds.width);
+  style.alignment = alignment;
+  style.maxLines = maxLines;
+  if (maxLines <= 0) {
+    float lineHeight = fontSize * 20.0f / 14.0f;
+    style.maxLines = std::max(1, (int)(bounds.height / lineHeight));
+  }
+
+  TextLayout::Draw(TextLayout::Get(text, style), {bounds.x, bounds.y},
+                   finalColor);
+}
+
 } // namespace raym3
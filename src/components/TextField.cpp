@@ -1,8 +1,10 @@
 #include "raym3/components/TextField.h"
 #include "raym3/components/Dialog.h"
 #include "raym3/components/Icon.h"
+#include "raym3/fonts/FontManager.h"
 #include "raym3/layout/Layout.h"
 #include "raym3/raym3.h"
+#include "raym3/rendering/RenderBackend.h"
 #include "raym3/rendering/Renderer.h"
 #include "raym3/styles/Theme.h"
 #include <algorithm>
@@ -46,6 +48,12 @@ struct TextFieldState {
 
   int lastActiveFrame = -1;
   bool wasFocused = false;
+
+  // prefixWidths[i] is the width of the first i bytes of measuredText, so
+  // caret, selection and hit testing read widths instead of measuring.
+  std::string measuredText;
+  uint64_t measuredFont = 0; // FontManager::GetFontId()
+  std::vector<float> prefixWidths;
 };
 
 static int activeFieldId_ = -1;
@@ -151,6 +159,80 @@ static int GetNextWordPos(const char *text, int pos) {
   return i;
 }
 
+// Records buffer, just edited by the field, as its value.
+static void CommitEdit(TextFieldState &state, const char *buffer) {
+  state.lastValue = buffer;
+}
+
+// Rebuilt only when the text differs from the last measured copy, however
+// it changed, or when the font changes or was a stand-in while glyphs
+// rasterize. Offsets inside a multi-byte codepoint get the width up to its
+// first byte.
+static const std::vector<float> &GetPrefixWidths(TextFieldState &state,
+                                                 const char *text) {
+  if (!text)
+    text = "";
+  int len = (int)strlen(text);
+  Font font = Theme::GetFont(16.0f, FontWeight::Regular);
+  uint64_t fontId = FontManager::GetFontId(font);
+  if (state.measuredFont == fontId && !state.prefixWidths.empty() &&
+      state.measuredText.size() == (size_t)len &&
+      memcmp(state.measuredText.data(), text, len) == 0)
+    return state.prefixWidths;
+
+  FontManager::EnsureGlyphs(font, text);
+  state.measuredText.assign(text, len);
+  state.measuredFont = FontManager::GetFontId(font);
+  std::vector<float> &widths = state.prefixWidths;
+  widths.assign(len + 1, 0.0f);
+  if (!font.glyphs || font.baseSize <= 0)
+    return widths;
+
+  // Same advances as raylib's MeasureTextEx with zero spacing.
+  float scale = 16.0f / (float)font.baseSize;
+  float width = 0.0f;
+  for (int i = 0; i < len;) {
+    int byteCount = 0;
+    int codepoint = GetCodepointNext(&text[i], &byteCount);
+    int index = FontManager::GetGlyphIndex(font, codepoint);
+
+    const GlyphInfo &glyph = font.glyphs[index];
+    if (glyph.advanceX != 0)
+      width += (float)glyph.advanceX;
+    else
+      width += font.recs[index].width + (float)glyph.offsetX;
+
+    int next = std::min(len, i + std::max(byteCount, 1));
+    for (int b = i + 1; b < next; b++)
+      widths[b] = widths[i];
+    widths[next] = width * scale;
+    i = next;
+  }
+  return widths;
+}
+
+static float PrefixWidth(const std::vector<float> &widths, int position) {
+  if (widths.empty() || position <= 0)
+    return 0.0f;
+  return widths[std::min(position, (int)widths.size() - 1)];
+}
+
+// Byte offset whose caret position is closest to x, preferring the earlier
+// one on ties.
+static int HitTestPrefix(const std::vector<float> &widths, float x) {
+  if (widths.empty())
+    return 0;
+  int i = (int)(std::lower_bound(widths.begin(), widths.end(), x) -
+                widths.begin());
+  if (i == (int)widths.size())
+    i--;
+  if (i > 0 && x - widths[i - 1] <= widths[i] - x)
+    i--;
+  while (i > 0 && widths[i - 1] == widths[i])
+    i--;
+  return i;
+}
+
 static void NormalizeSelection(int &start, int &end) {
   if (start == -1 || end == -1) {
     start = -1;
@@ -162,34 +244,28 @@ static void NormalizeSelection(int &start, int &end) {
   }
 }
 
-static void DrawSelection(Rectangle bounds, const char *text, int start,
-                          int end, float scrollOffset, float padding) {
+static void DrawSelection(Rectangle bounds, const std::vector<float> &widths,
+                          int start, int end, float scrollOffset,
+                          float padding) {
   if (start == -1 || end == -1 || start == end)
     return;
-  if (!text)
-    return;
 
   NormalizeSelection(start, end);
 
   ColorScheme &scheme = Theme::GetColorScheme();
 
-  std::string textBeforeStart(text, start);
-  std::string textBeforeEnd(text, end);
-
-  Vector2 startSize = Renderer::MeasureText(textBeforeStart.c_str(), 16.0f,
-                                            FontWeight::Regular);
-  Vector2 endSize =
-      Renderer::MeasureText(textBeforeEnd.c_str(), 16.0f, FontWeight::Regular);
+  float startX = PrefixWidth(widths, start);
+  float endX = PrefixWidth(widths, end);
 
-  float selectionX = bounds.x + padding - scrollOffset + startSize.x;
-  float selectionWidth = endSize.x - startSize.x;
+  float selectionX = bounds.x + padding - scrollOffset + startX;
+  float selectionWidth = endX - startX;
   float selectionY = bounds.y + (bounds.height - 16.0f) / 2.0f;
   float selectionHeight = 16.0f;
 
   Color selectionColor = scheme.primary;
   selectionColor.a = 76;
 
-  DrawRectangleRec({selectionX, selectionY, selectionWidth, selectionHeight},
+  Renderer::DrawRectangle({selectionX, selectionY, selectionWidth, selectionHeight},
                    selectionColor);
 }
 
@@ -412,6 +488,9 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
   }
   float availableWidth = textEndX - textStartX;
 
+  // Refreshed after typing below; nothing before that edits the text.
+  const std::vector<float> &prefixWidths = GetPrefixWidths(fieldState, buffer);
+
   if (clickedInField && !options.readOnly) {
     bool wasFocused = (activeFieldId_ == fieldId);
     activeFieldId_ = fieldId;
@@ -422,17 +501,8 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
     int clickPosition = len;
 
     if (len > 0) {
-      float closestDiff = 10000.0f;
-      for (int i = 0; i <= len; i++) {
-        std::string sub(buffer, i);
-        Vector2 size =
-            Renderer::MeasureText(sub.c_str(), 16.0f, FontWeight::Regular);
-        float diff = std::abs(size.x - clickRelativeX);
-        if (diff < closestDiff) {
-          closestDiff = diff;
-          clickPosition = i;
-        }
-      }
+      clickPosition =
+          HitTestPrefix(prefixWidths, clickRelativeX);
     }
 
     float currentTime = GetTime();
@@ -494,23 +564,14 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
     } else if (mousePos.x > textEndX) {
       float distance = mousePos.x - textEndX;
       float scrollAmount = std::min(autoScrollSpeed * (distance / 50.0f), autoScrollSpeed * 2.0f);
-      Vector2 totalSize = Renderer::MeasureText(buffer, 16.0f, FontWeight::Regular);
-      float maxScroll = std::max(0.0f, totalSize.x - availableWidth);
+      float totalWidth = prefixWidths.back();
+      float maxScroll = std::max(0.0f, totalWidth - availableWidth);
       fieldState.scrollOffset = std::min(maxScroll, fieldState.scrollOffset + scrollAmount);
     }
 
     if (len > 0) {
-      float closestDiff = 10000.0f;
-      for (int i = 0; i <= len; i++) {
-        std::string sub(buffer, i);
-        Vector2 size =
-            Renderer::MeasureText(sub.c_str(), 16.0f, FontWeight::Regular);
-        float diff = std::abs(size.x - dragRelativeX);
-        if (diff < closestDiff) {
-          closestDiff = diff;
-          dragPosition = i;
-        }
-      }
+      dragPosition =
+          HitTestPrefix(prefixWidths, dragRelativeX);
     }
 
     if (fieldState.selectionStart == -1) {
@@ -575,10 +636,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
   float availableWidthForScroll = textEndX - textStartX;
 
   if (activeFieldId_ == fieldId) {
-    std::string textBeforeCursor(buffer, fieldState.cursorPosition);
-    Vector2 cursorSize = Renderer::MeasureText(textBeforeCursor.c_str(), 16.0f,
-                                               FontWeight::Regular);
-    float cursorX = cursorSize.x;
+    float cursorX = PrefixWidth(prefixWidths, fieldState.cursorPosition);
 
     if (cursorX - fieldState.scrollOffset > availableWidthForScroll) {
       fieldState.scrollOffset = cursorX - availableWidthForScroll;
@@ -586,18 +644,16 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
       fieldState.scrollOffset = cursorX;
     }
 
-    Vector2 totalSize =
-        Renderer::MeasureText(buffer, 16.0f, FontWeight::Regular);
-    float maxScroll = std::max(0.0f, totalSize.x - availableWidthForScroll);
+    float maxScroll =
+        std::max(0.0f, prefixWidths.back() - availableWidthForScroll);
     if (fieldState.scrollOffset > maxScroll)
       fieldState.scrollOffset = maxScroll;
     if (fieldState.scrollOffset < 0)
       fieldState.scrollOffset = 0;
   } else {
-    Vector2 totalSize =
-        Renderer::MeasureText(buffer ? buffer : "", 16.0f, FontWeight::Regular);
-    if (totalSize.x > availableWidthForScroll) {
-      fieldState.scrollOffset = totalSize.x - availableWidthForScroll;
+    float totalWidth = prefixWidths.back();
+    if (totalWidth > availableWidthForScroll) {
+      fieldState.scrollOffset = totalWidth - availableWidthForScroll;
     } else {
       fieldState.scrollOffset = 0.0f;
     }
@@ -611,8 +667,8 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
   if (scissorWidth > 0 && scissorHeight > 0) {
     int scissorX = (int)std::floor(textStartX);
     int scissorY = (int)std::floor(inputBounds.y);
-    int screenW = GetScreenWidth();
-    int screenH = GetScreenHeight();
+    int screenW = RenderBackend::Get()->GetScreenWidth();
+    int screenH = RenderBackend::Get()->GetScreenHeight();
     if (scissorX < 0) { scissorWidth += scissorX; scissorX = 0; }
     if (scissorY < 0) { scissorHeight += scissorY; scissorY = 0; }
     if (scissorX + scissorWidth > screenW) scissorWidth = screenW - scissorX;
@@ -639,8 +695,8 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
     int drawEnd = fieldState.selectionEnd;
     NormalizeSelection(drawStart, drawEnd);
     if (drawStart != -1 && drawEnd != -1) {
-      DrawSelection(inputBounds, buffer, drawStart, drawEnd, currentScroll,
-                    textStartX - inputBounds.x);
+      DrawSelection(inputBounds, prefixWidths, drawStart, drawEnd,
+                    currentScroll, textStartX - inputBounds.x);
     }
   }
 
@@ -683,8 +739,9 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
             if (options.variant == TextFieldVariant::Filled && options.drawBackground) {
               fadeColor = (options.backgroundColor.a > 0) ? options.backgroundColor : scheme.surfaceContainerHighest;
             }
-            DrawRectangle((int)(fadeStartX + i), (int)inputBounds.y, 1, (int)inputBounds.height, 
-                          ColorAlpha(fadeColor, alpha));
+            Renderer::DrawRectangle({(float)(int)(fadeStartX + i), (float)(int)inputBounds.y,
+                                     1.0f, (float)(int)inputBounds.height},
+                                    ColorAlpha(fadeColor, alpha));
           }
         }
       }
@@ -874,7 +931,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
           if (newLen >= bufferSize) {
             buffer[bufferSize - 1] = '\0';
           }
-          fieldState.lastValue = std::string(buffer);
+          CommitEdit(fieldState, buffer);
         }
       }
       key = GetCharPressed();
@@ -882,7 +939,10 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
 
     if (!skipTextRendering) {
       UpdateCursor(buffer, bufferSize, fieldState.lastBlinkTime);
-      DrawCursor(inputBounds, buffer, fieldState.cursorPosition,
+      // Rebuilds prefixWidths if the keys typed above edited the text.
+      DrawCursor(inputBounds,
+                 PrefixWidth(GetPrefixWidths(fieldState, buffer),
+                             fieldState.cursorPosition),
                  fieldState.scrollOffset, fieldState.lastBlinkTime,
                  textStartX - inputBounds.x, bgColor);
     }
@@ -917,7 +977,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
           fieldState.cursorPosition = sStart;
           fieldState.selectionStart = -1;
           fieldState.selectionEnd = -1;
-          fieldState.lastValue = std::string(buffer);
+          CommitEdit(fieldState, buffer);
         } else if (isCmdDown && fieldState.cursorPosition > 0) {
           SaveToHistory(fieldState, std::string(buffer ? buffer : ""),
                         options.maxUndoHistory);
@@ -925,7 +985,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
           memmove(&buffer[0], &buffer[fieldState.cursorPosition],
                   (size_t)(len - fieldState.cursorPosition + 1));
           fieldState.cursorPosition = 0;
-          fieldState.lastValue = std::string(buffer);
+          CommitEdit(fieldState, buffer);
         } else if (isAltDown && fieldState.cursorPosition > 0) {
           int prevWordPos = GetPrevWordPos(buffer, fieldState.cursorPosition);
           SaveToHistory(fieldState, std::string(buffer ? buffer : ""),
@@ -934,7 +994,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
           memmove(&buffer[prevWordPos], &buffer[fieldState.cursorPosition],
                   (size_t)(len - fieldState.cursorPosition + 1));
           fieldState.cursorPosition = prevWordPos;
-          fieldState.lastValue = std::string(buffer);
+          CommitEdit(fieldState, buffer);
         } else if (fieldState.cursorPosition > 0) {
           SaveToHistory(fieldState, std::string(buffer ? buffer : ""),
                         options.maxUndoHistory);
@@ -943,7 +1003,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
                   &buffer[fieldState.cursorPosition],
                   (size_t)(len - fieldState.cursorPosition + 1));
           fieldState.cursorPosition--;
-          fieldState.lastValue = std::string(buffer);
+          CommitEdit(fieldState, buffer);
         }
       }
     }
@@ -962,7 +1022,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
         fieldState.cursorPosition = sStart;
         fieldState.selectionStart = -1;
         fieldState.selectionEnd = -1;
-        fieldState.lastValue = std::string(buffer);
+        CommitEdit(fieldState, buffer);
       } else if (isAltDown && fieldState.cursorPosition < (int)strlen(buffer)) {
         int nextWordPos = GetNextWordPos(buffer, fieldState.cursorPosition);
         SaveToHistory(fieldState, std::string(buffer ? buffer : ""),
@@ -970,7 +1030,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
         int len = (int)strlen(buffer);
         memmove(&buffer[fieldState.cursorPosition], &buffer[nextWordPos],
                 (size_t)(len - nextWordPos + 1));
-        fieldState.lastValue = std::string(buffer);
+        CommitEdit(fieldState, buffer);
       } else if (fieldState.cursorPosition < (int)strlen(buffer)) {
         SaveToHistory(fieldState, std::string(buffer ? buffer : ""),
                       options.maxUndoHistory);
@@ -978,7 +1038,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
         memmove(&buffer[fieldState.cursorPosition],
                 &buffer[fieldState.cursorPosition + 1],
                 (size_t)(len - fieldState.cursorPosition));
-        fieldState.lastValue = std::string(buffer);
+        CommitEdit(fieldState, buffer);
       }
     }
 
@@ -1023,7 +1083,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
         fieldState.cursorPosition = fieldState.selectionStart;
         fieldState.selectionStart = -1;
         fieldState.selectionEnd = -1;
-        fieldState.lastValue = std::string(buffer);
+        CommitEdit(fieldState, buffer);
       }
     }
 
@@ -1075,7 +1135,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
 
             memcpy(&buffer[fieldState.cursorPosition], clipboard, toCopy);
             fieldState.cursorPosition += toCopy;
-            fieldState.lastValue = std::string(buffer);
+            CommitEdit(fieldState, buffer);
           }
         }
       }
@@ -1102,7 +1162,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
                   bufferSize - 1);
           buffer[bufferSize - 1] = '\0';
           fieldState.cursorPosition = (int)strlen(buffer);
-          fieldState.lastValue = std::string(buffer);
+          CommitEdit(fieldState, buffer);
           fieldState.selectionStart = -1;
           fieldState.selectionEnd = -1;
           fieldState.isUndoRedoOperation = false;
@@ -1130,7 +1190,7 @@ bool TextFieldComponent::Render(char *buffer, int bufferSize, Rectangle bounds,
                   bufferSize - 1);
           buffer[bufferSize - 1] = '\0';
           fieldState.cursorPosition = (int)strlen(buffer);
-          fieldState.lastValue = std::string(buffer);
+          CommitEdit(fieldState, buffer);
           fieldState.selectionStart = -1;
           fieldState.selectionEnd = -1;
           fieldState.isUndoRedoOperation = false;
@@ -1202,10 +1262,9 @@ void TextFieldComponent::UpdateCursor(char *buffer, int bufferSize,
   // lastBlinkTime is only reset on user input to restart blink cycle.
 }
 
-void TextFieldComponent::DrawCursor(Rectangle bounds, const char *text,
-                                    int position, float scrollOffset,
-                                    float lastBlinkTime, float textStartX,
-                                    Color bgColor) {
+void TextFieldComponent::DrawCursor(Rectangle bounds, float cursorOffset,
+                                    float scrollOffset, float lastBlinkTime,
+                                    float textStartX, Color bgColor) {
   float currentTime = GetTime();
   float blinkCycle = (currentTime - lastBlinkTime) * 2.0f;
   bool showCursor = ((int)blinkCycle % 2 == 0);
@@ -1217,17 +1276,7 @@ void TextFieldComponent::DrawCursor(Rectangle bounds, const char *text,
   // prevent flicker during rapid repeat
   if (showCursor || IsKeyDown(KEY_BACKSPACE) || IsKeyDown(KEY_LEFT) ||
       IsKeyDown(KEY_RIGHT)) {
-    float cursorX = bounds.x + textStartX - scrollOffset;
-    if (text && position > 0) {
-      int textLen = (int)strlen(text);
-      int pos = (position <= textLen) ? position : textLen;
-      if (pos > 0) {
-        std::string textBeforeCursor(text, pos);
-        Vector2 textSize = Renderer::MeasureText(textBeforeCursor.c_str(),
-                                                 16.0f, FontWeight::Regular);
-        cursorX += textSize.x;
-      }
-    }
+    float cursorX = bounds.x + textStartX - scrollOffset + cursorOffset;
 
     Color cursorColor = Theme::GetColorScheme().onSurface;
 
@@ -1252,8 +1301,9 @@ void TextFieldComponent::DrawCursor(Rectangle bounds, const char *text,
     float cursorHeight = 16.0f;
     float cursorY = bounds.y + (bounds.height - cursorHeight) / 2.0f;
 
-    DrawLine((int)cursorX, (int)cursorY, (int)cursorX,
-             (int)(cursorY + cursorHeight), cursorColor);
+    Renderer::DrawRectangle({(float)(int)cursorX, (float)(int)cursorY, 1.0f,
+                             (float)((int)(cursorY + cursorHeight) - (int)cursorY)},
+                            cursorColor);
   }
 }
 
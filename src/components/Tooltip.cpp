@@ -1,6 +1,8 @@
 #include "raym3/components/Tooltip.h"
 #include "raym3/components/Button.h"
+#include "raym3/rendering/RenderBackend.h"
 #include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/TextLayout.h"
 #include "raym3/raym3.h"
 #include "raym3/styles/Theme.h"
 #include <algorithm>
@@ -38,6 +40,20 @@ static bool IsSameAnchor(Rectangle a, Rectangle b) {
   return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
 }
 
+//-----------------------------------------------------------------------------
+// Helper: Wrapped body text styles (Body Medium, 14sp)
+//-----------------------------------------------------------------------------
+static constexpr float kPlainPadding = 8.0f;
+static constexpr float kRichPadding = 12.0f;
+static constexpr float kRichMaxWidth = 312.0f;
+
+static TextLayoutStyle BodyStyle(const TooltipOptions &options) {
+  TextLayoutStyle style;
+  style.maxWidth = options.IsRich() ? kRichMaxWidth - kRichPadding * 2
+                                    : options.maxWidth - kPlainPadding * 2;
+  return style;
+}
+
 //-----------------------------------------------------------------------------
 // Smart timing helpers
 //-----------------------------------------------------------------------------
@@ -153,8 +169,8 @@ void TooltipManager::RequestTooltip(Rectangle anchor, const char *text,
 
 Rectangle TooltipManager::ComputePosition(Rectangle anchor, Vector2 contentSize,
                                           TooltipPlacement placement) {
-  int screenW = GetScreenWidth();
-  int screenH = GetScreenHeight();
+  int screenW = RenderBackend::Get()->GetScreenWidth();
+  int screenH = RenderBackend::Get()->GetScreenHeight();
   float gap = 8.0f;
 
   Rectangle result = {0, 0, contentSize.x, contentSize.y};
@@ -224,11 +240,10 @@ void TooltipManager::RenderPlainTooltip(Rectangle bounds, const char *text) {
   Renderer::DrawElevatedRectangle(bounds, cornerRadius, 2, scheme.inverseSurface);
 
   // Draw text centered
-  float padding = 8.0f;
-  Vector2 textPos = {bounds.x + padding,
-                     bounds.y + (bounds.height - 14.0f) / 2.0f};
-  Renderer::DrawText(text, textPos, 14.0f, scheme.inverseOnSurface,
-                     FontWeight::Regular);
+  const TextLayoutResult &layout = TextLayout::Get(text, BodyStyle(options_));
+  Vector2 textPos = {bounds.x + kPlainPadding,
+                     bounds.y + (bounds.height - layout.size.y) / 2.0f};
+  TextLayout::Draw(layout, textPos, scheme.inverseOnSurface);
 }
 
 void TooltipManager::RenderRichTooltip(Rectangle bounds, const char *title,
@@ -242,7 +257,7 @@ void TooltipManager::RenderRichTooltip(Rectangle bounds, const char *title,
   // - Body: onSurfaceVariant, 14sp
   // - Corner radius: 12dp (medium)
   float cornerRadius = 12.0f;
-  float padding = 12.0f;
+  float padding = kRichPadding;
 
   // Draw background
   Renderer::DrawElevatedRectangle(bounds, cornerRadius, 3,
@@ -260,10 +275,9 @@ void TooltipManager::RenderRichTooltip(Rectangle bounds, const char *title,
 
   // Body text
   if (text && strlen(text) > 0) {
-    Vector2 textPos = {bounds.x + padding, y};
-    Renderer::DrawText(text, textPos, 14.0f, scheme.onSurfaceVariant,
-                       FontWeight::Regular);
-    y += 20.0f;
+    const TextLayoutResult &layout = TextLayout::Get(text, BodyStyle(options));
+    TextLayout::Draw(layout, {bounds.x + padding, y}, scheme.onSurfaceVariant);
+    y += layout.size.y;
   }
 
   // Action button
@@ -287,11 +301,13 @@ void TooltipManager::RenderRichTooltip(Rectangle bounds, const char *title,
     // Draw hover state
     if (isHovered) {
       Color hoverColor = ColorAlpha(scheme.primary, 0.08f);
-      DrawRectangleRounded(btnBounds, 0.5f, 4, hoverColor);
+      Renderer::DrawRoundedRectangle(
+          btnBounds, std::min(btnBounds.width, btnBounds.height) * 0.25f, hoverColor);
     }
     if (isPressed) {
       Color pressColor = ColorAlpha(scheme.primary, 0.12f);
-      DrawRectangleRounded(btnBounds, 0.5f, 4, pressColor);
+      Renderer::DrawRoundedRectangle(
+          btnBounds, std::min(btnBounds.width, btnBounds.height) * 0.25f, pressColor);
     }
 
     // Draw button text
@@ -314,8 +330,8 @@ void TooltipManager::RenderPendingTooltip() {
 
   // Calculate content size based on tooltip type
   Vector2 contentSize;
-  float padding = options_.IsRich() ? 12.0f : 8.0f;
-  float maxWidth = options_.IsRich() ? 312.0f : options_.maxWidth;
+  float padding = options_.IsRich() ? kRichPadding : kPlainPadding;
+  float maxWidth = options_.IsRich() ? kRichMaxWidth : options_.maxWidth;
 
   if (options_.IsRich()) {
     // Rich tooltip size calculation
@@ -331,9 +347,9 @@ void TooltipManager::RenderPendingTooltip() {
 
     if (!text_.empty()) {
       Vector2 textSize =
-          Renderer::MeasureText(text_.c_str(), 14.0f, FontWeight::Regular);
+          TextLayout::Measure(text_.c_str(), BodyStyle(options_));
       width = std::max(width, textSize.x + padding * 2);
-      height += 20.0f;
+      height += textSize.y;
     }
 
     if (options_.actionText) {
@@ -346,11 +362,11 @@ void TooltipManager::RenderPendingTooltip() {
     width = std::min(width, maxWidth);
     contentSize = {width, height};
   } else {
-    // Plain tooltip size calculation
-    Vector2 textSize =
-        Renderer::MeasureText(text_.c_str(), 14.0f, FontWeight::Regular);
+    // Plain tooltip size calculation: wrapped at maxWidth, 4dp above and
+    // below (28dp for one line)
+    Vector2 textSize = TextLayout::Measure(text_.c_str(), BodyStyle(options_));
     contentSize.x = std::min(textSize.x + padding * 2, maxWidth);
-    contentSize.y = 28.0f; // Fixed height for plain tooltip
+    contentSize.y = textSize.y + 8.0f;
   }
 
   // Compute position with edge avoidance
@@ -2,6 +2,10 @@
 #include "raym3/components/TabBar.h"
 #include "raym3/layout/Layout.h"
 #include "raym3/raym3.h"
+#include "raym3/rendering/DrawCommandBuffer.h"
+#include "raym3/rendering/RenderBackend.h"
+#include "raym3/rendering/Renderer.h"
+#include "raym3/styles/Theme.h"
 #include <algorithm>
 #include <raylib.h>
 #include <rlgl.h>
@@ -212,7 +216,8 @@ void View3D::SetCornerRadius(float radius) { cornerRadius_ = radius; }
 int View3D::Render(Rectangle bounds, std::function<void()> renderCallback,
                    Shader postProcessShader,
                    std::function<void(int width, int height)> setPostProcessUniforms) {
-  if (!shaderLoaded_) {
+  bool hasGpu = RenderBackend::Get()->HasGpuContext();
+  if (!shaderLoaded_ && hasGpu) {
     LoadRoundedShader();
   }
 
@@ -239,11 +244,20 @@ int View3D::Render(Rectangle bounds, std::function<void()> renderCallback,
   layerId_ = -1;
 #endif
 
+  // Scenes are drawn with raylib directly and need a GL context. Headless
+  // backends get a placeholder with the viewport's shape instead.
+  if (!hasGpu) {
+    Renderer::DrawRoundedRectangle(
+        bounds, cornerRadius_, Theme::GetColorScheme().surfaceContainerHighest);
+    return layerId_;
+  }
+
   EnsureTextureSize(width, height);
 
   // 1. Render scene to texture
   // Suspend GPU scissor for FBO (screen coords don't apply) but keep stack intact
   // so sibling panels (Inspector) still get correct parent clip on PushScissor
+  DrawCommandBuffer::Flush();
   rlDrawRenderBatchActive();
   EndScissorMode();
 
@@ -305,6 +319,9 @@ int View3D::Render(Rectangle bounds, std::function<void()> renderCallback,
   }
 
   BeginScissor({left, top, right - left, bottom - top});
+  // The shader draw below bypasses the command buffer; emit what precedes it
+  // and apply the viewport scissor first.
+  DrawCommandBuffer::Flush();
   
   // Apply rounded corner shader if loaded
   if (shaderLoaded_ && shader_.id != rlGetShaderIdDefault()) {
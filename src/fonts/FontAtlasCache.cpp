@@ -0,0 +1,210 @@
+#include "raym3/fonts/FontAtlasCache.h"
+#include "raym3/rendering/MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <raylib.h>
+
+namespace raym3 {
+
+// Bump when the layout below or the way glyphs are rasterized changes.
+static constexpr uint32_t kFormatVersion = 1;
+static constexpr char kMagic[4] = {'R', 'M', '3', 'G'};
+static constexpr uint16_t kHasPixels = 1;
+
+struct FileHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t rasterizer; // Hash of RAYLIB_VERSION
+  uint64_t faceHash;
+  int32_t size;
+  uint32_t glyphCount;
+  uint32_t pixelBytes;
+  uint32_t reserved;
+  uint64_t checksum; // Hash of the records and pixels that follow
+};
+
+struct GlyphRecord {
+  int32_t codepoint;
+  int16_t offsetX;
+  int16_t offsetY;
+  int16_t advanceX;
+  uint16_t width;
+  uint16_t height;
+  uint16_t flags;
+  uint32_t pixelOffset; // Into the pixel block after the records
+};
+
+static_assert(sizeof(FileHeader) == 48, "FileHeader must not be padded");
+static_assert(sizeof(GlyphRecord) == 20, "GlyphRecord must not be padded");
+
+std::string FontAtlasCache::directory_;
+FontAtlasCacheStats FontAtlasCache::stats_;
+
+static uint64_t RasterizerHash() {
+  return FontAtlasCache::Hash(RAYLIB_VERSION, strlen(RAYLIB_VERSION));
+}
+
+void FontAtlasCache::SetDirectory(const std::string &directory) {
+  directory_ = directory;
+}
+
+uint64_t FontAtlasCache::Hash(const void *data, size_t size) {
+  uint64_t h = 0xcbf29ce484222325ull;
+  const unsigned char *bytes = (const unsigned char *)data;
+  for (size_t i = 0; i < size; i++) {
+    h ^= bytes[i];
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+std::string FontAtlasCache::FilePath(uint64_t faceHash, int size) {
+  char name[48];
+  snprintf(name, sizeof(name), "%016llx-%d.glyphs",
+           (unsigned long long)faceHash, size);
+  return (std::filesystem::path(directory_) / name).string();
+}
+
+bool FontAtlasCache::Load(
+    uint64_t faceHash, int size,
+    const std::function<void(const std::vector<CachedGlyph> &)> &use) {
+  if (!IsEnabled())
+    return false;
+  MappedFile file(FilePath(faceHash, size));
+  if (!file.data())
+    return false;
+
+  FileHeader header;
+  bool valid = file.size() >= sizeof(header);
+  if (valid) {
+    memcpy(&header, file.data(), sizeof(header));
+    size_t records = (size_t)header.glyphCount * sizeof(GlyphRecord);
+    valid = memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+            header.version == kFormatVersion &&
+            header.rasterizer == RasterizerHash() &&
+            header.faceHash == faceHash && header.size == size &&
+            file.size() == sizeof(header) + records + header.pixelBytes &&
+            header.checksum == Hash(file.data() + sizeof(header),
+                                    file.size() - sizeof(header));
+  }
+  if (!valid) {
+    stats_.filesRejected++;
+    return false;
+  }
+
+  // Records are 4-byte aligned after the 48-byte header, and mmap returns
+  // page-aligned memory, so they can be read in place.
+  const GlyphRecord *records =
+      (const GlyphRecord *)(file.data() + sizeof(header));
+  const unsigned char *pixels =
+      file.data() + sizeof(header) + header.glyphCount * sizeof(GlyphRecord);
+  std::vector<CachedGlyph> glyphs;
+  glyphs.reserve(header.glyphCount);
+  for (uint32_t i = 0; i < header.glyphCount; i++) {
+    const GlyphRecord &record = records[i];
+    CachedGlyph glyph = {record.codepoint, record.offsetX, record.offsetY,
+                         record.advanceX,  record.width,   record.height,
+                         nullptr};
+    if (record.flags & kHasPixels) {
+      size_t bytes = (size_t)record.width * record.height;
+      if ((size_t)record.pixelOffset + bytes > header.pixelBytes)
+        continue;
+      glyph.pixels = pixels + record.pixelOffset;
+    }
+    glyphs.push_back(glyph);
+  }
+  use(glyphs);
+  stats_.glyphsLoaded += (int)glyphs.size();
+  stats_.filesLoaded++;
+  return true;
+}
+
+static bool FitsRecord(const CachedGlyph &glyph) {
+  auto fits16 = [](int value) { return value >= -32768 && value <= 32767; };
+  return fits16(glyph.offsetX) && fits16(glyph.offsetY) &&
+         fits16(glyph.advanceX) && glyph.width >= 0 && glyph.width <= 65535 &&
+         glyph.height >= 0 && glyph.height <= 65535;
+}
+
+bool FontAtlasCache::Save(uint64_t faceHash, int size,
+                          const std::vector<CachedGlyph> &glyphs) {
+  if (!IsEnabled())
+    return false;
+
+  std::vector<const CachedGlyph *> sorted;
+  sorted.reserve(glyphs.size());
+  for (const CachedGlyph &glyph : glyphs) {
+    if (FitsRecord(glyph))
+      sorted.push_back(&glyph);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const CachedGlyph *a, const CachedGlyph *b) {
+              return a->codepoint < b->codepoint;
+            });
+
+  std::vector<GlyphRecord> records;
+  std::vector<unsigned char> pixels;
+  records.reserve(sorted.size());
+  for (const CachedGlyph *glyph : sorted) {
+    GlyphRecord record = {};
+    record.codepoint = glyph->codepoint;
+    record.offsetX = (int16_t)glyph->offsetX;
+    record.offsetY = (int16_t)glyph->offsetY;
+    record.advanceX = (int16_t)glyph->advanceX;
+    record.width = (uint16_t)glyph->width;
+    record.height = (uint16_t)glyph->height;
+    if (glyph->pixels && glyph->width > 0 && glyph->height > 0) {
+      record.flags = kHasPixels;
+      record.pixelOffset = (uint32_t)pixels.size();
+      pixels.insert(pixels.end(), glyph->pixels,
+                    glyph->pixels + (size_t)glyph->width * glyph->height);
+    }
+    records.push_back(record);
+  }
+
+  FileHeader header = {};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kFormatVersion;
+  header.rasterizer = RasterizerHash();
+  header.faceHash = faceHash;
+  header.size = size;
+  header.glyphCount = (uint32_t)records.size();
+  header.pixelBytes = (uint32_t)pixels.size();
+
+  std::vector<unsigned char> payload(records.size() * sizeof(GlyphRecord) +
+                                     pixels.size());
+  if (!records.empty())
+    memcpy(payload.data(), records.data(),
+           records.size() * sizeof(GlyphRecord));
+  if (!pixels.empty())
+    memcpy(payload.data() + records.size() * sizeof(GlyphRecord),
+           pixels.data(), pixels.size());
+  header.checksum = Hash(payload.data(), payload.size());
+
+  std::error_code error;
+  std::filesystem::create_directories(directory_, error);
+  std::string path = FilePath(faceHash, size);
+  std::string temporary = path + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write((const char *)&header, sizeof(header));
+    file.write((const char *)payload.data(), (std::streamsize)payload.size());
+    if (!file.good()) {
+      file.close();
+      std::filesystem::remove(temporary, error);
+      return false;
+    }
+  }
+  std::filesystem::rename(temporary, path, error);
+  if (error) {
+    std::filesystem::remove(temporary, error);
+    return false;
+  }
+  stats_.filesWritten++;
+  return true;
+}
+
+} // namespace raym3
@@ -1,55 +1,745 @@
 #include "raym3/fonts/FontManager.h"
 #include "raym3/config.h"
+#include "raym3/fonts/FontAtlasCache.h"
+#include "raym3/fonts/GlyphAtlas.h"
+#include "raym3/rendering/PerfCounters.h"
+#include "raym3/rendering/PrewarmManifest.h"
+#include "raym3/rendering/RenderBackend.h"
+#include "raym3/rendering/TextLayout.h"
+#include "raym3/rendering/TextMeasureCache.h"
 #include "EmbeddedFonts.h"
 #include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 
 namespace raym3 {
 
-std::unordered_map<FontKey, Font, FontKeyHash> FontManager::fontCache_;
-Font FontManager::defaultFont_ = {0};
+// Printable ASCII, as raylib's LoadFontFromMemory() default. These always
+// occupy the first slots, so their index is codepoint - kFirstCodepoint.
+static constexpr int kFirstCodepoint = 32;
+static constexpr int kGlyphCount = 95;
+static constexpr int kMissingGlyph = '?' - kFirstCodepoint;
+// Transparent border around each glyph in the atlas; Renderer draws it so
+// filtered and scaled edges fade out instead of being cut.
+static constexpr int kGlyphPadding = 2;
+// Bake size of distance-field fonts. The field spans 4 texels around each
+// glyph (raylib's FONT_SDF padding), enough to anti-alias down to ~8px.
+static constexpr int kSdfBaseSize = 32;
+
+static bool IsAscii(int codepoint) {
+  return codepoint >= kFirstCodepoint &&
+         codepoint < kFirstCodepoint + kGlyphCount;
+}
+
+FontManager::FontFace FontManager::regularFace_ = {
+    Roboto_v3_012_hinted_static_Roboto_Regular_ttf,
+    (int)Roboto_v3_012_hinted_static_Roboto_Regular_ttf_len,
+    {}};
+FontManager::FontFace FontManager::boldFace_ = {
+    Roboto_v3_012_hinted_static_Roboto_Bold_ttf,
+    (int)Roboto_v3_012_hinted_static_Roboto_Bold_ttf_len,
+    {}};
+std::unordered_map<std::string, std::unique_ptr<FontManager::FontFace>>
+    FontManager::customFaces_;
+std::vector<const FontManager::FontFace *> FontManager::fallbackFaces_;
+std::unordered_map<FontKey, FontManager::FontEntry *, FontKeyHash>
+    FontManager::fontCache_;
+std::unordered_map<const GlyphInfo *, std::unique_ptr<FontManager::FontEntry>>
+    FontManager::entries_;
+std::unordered_map<const GlyphInfo *, FontManager::FontEntry *>
+    FontManager::aliases_;
+std::vector<FontManager::RetiredGlyphs> FontManager::retired_;
+uint64_t FontManager::nextFontId_ = 1;
+uint64_t FontManager::frameCount_ = 1;
+FontManager::FontEntry *FontManager::defaultEntry_ = nullptr;
+std::unordered_map<const FontManager::FontFace *, Font>
+    FontManager::sdfFonts_;
+bool FontManager::sdfEnabled_ = false;
 bool FontManager::initialized_ = false;
+bool FontManager::asyncGlyphs_ = true;
+std::vector<std::thread> FontManager::workers_;
+std::mutex FontManager::jobMutex_;
+std::condition_variable FontManager::jobReady_;
+std::deque<FontManager::GlyphJob> FontManager::jobs_;
+std::vector<FontManager::GlyphBatch> FontManager::finished_;
+int FontManager::jobsInFlight_ = 0;
+bool FontManager::stopWorkers_ = false;
+
 void FontManager::Initialize() {
   if (initialized_)
     return;
 
-  defaultFont_ = LoadFont(FontWeight::Regular, FontStyle::Normal, 16);
+  // Always a bitmap font, whatever the SDF setting.
+  defaultEntry_ = CreateEntry(&regularFace_, 16);
+  fontCache_[{FontWeight::Regular, FontStyle::Normal, 16}] = defaultEntry_;
   initialized_ = true;
 }
 
 void FontManager::Shutdown() {
-  for (auto &[key, font] : fontCache_) {
-    if (font.texture.id != 0) {
-      UnloadFont(font);
-    }
+  StopWorkers();
+  SaveGlyphCache();
+  EndFrame();
+  for (auto &[glyphs, entry] : entries_) {
+    MemFree(entry->font.glyphs);
+    MemFree(entry->font.recs);
   }
+  entries_.clear();
   fontCache_.clear();
-
-  // defaultFont_ is a copy of a font in fontCache_, so it's already unloaded.
-  defaultFont_ = {0};
+  for (auto &[face, font] : sdfFonts_) {
+    UnloadFontData(font.glyphs, font.glyphCount);
+    RenderBackend::Get()->UnloadTexture(font.texture);
+    MemFree(font.recs);
+  }
+  sdfFonts_.clear();
+  TextMeasureCache::Clear();
+  TextLayout::Clear();
+  fallbackFaces_.clear();
+  customFaces_.clear();
+  defaultEntry_ = nullptr;
+  GlyphAtlas::Shutdown();
 
   initialized_ = false;
 }
 
-Font FontManager::LoadFont(FontWeight weight, FontStyle style, int size) {
-  FontKey key{weight, style, size};
+void FontManager::EndFrame() {
+  for (const RetiredGlyphs &retired : retired_) {
+    MemFree(retired.glyphs);
+    MemFree(retired.recs);
+  }
+  retired_.clear();
+  aliases_.clear();
+  frameCount_++;
+}
 
-  auto it = fontCache_.find(key);
-  if (it != fontCache_.end()) {
-    return it->second;
+FontManager::FontEntry *FontManager::CreateEntry(const FontFace *face,
+                                                 int size) {
+  auto entry = std::make_unique<FontEntry>();
+  entry->id = nextFontId_++;
+  entry->face = face;
+  entry->capacity = kGlyphCount;
+  entry->generation = GlyphAtlas::GetGeneration();
+  entry->ready.assign(kGlyphCount, false);
+  entry->usedFrame = 0;
+  entry->diskChecked = false;
+  entry->diskDirty = false;
+
+  Font &font = entry->font;
+  font = {0};
+  font.baseSize = size;
+  font.glyphCount = kGlyphCount;
+  font.glyphPadding = kGlyphPadding;
+  font.glyphs = (GlyphInfo *)MemAlloc(kGlyphCount * sizeof(GlyphInfo));
+  font.recs = (Rectangle *)MemAlloc(kGlyphCount * sizeof(Rectangle));
+  // MemAlloc zero-fills; only the codepoints are needed for GetGlyphIndex().
+  for (int i = 0; i < kGlyphCount; i++)
+    font.glyphs[i].value = kFirstCodepoint + i;
+  font.texture = GlyphAtlas::GetTexture();
+
+  FontEntry *raw = entry.get();
+  entries_[font.glyphs] = std::move(entry);
+  return raw;
+}
+
+void FontManager::DestroyEntry(FontEntry *entry) {
+  for (auto it = fontCache_.begin(); it != fontCache_.end();) {
+    if (it->second == entry)
+      it = fontCache_.erase(it);
+    else
+      ++it;
+  }
+  for (auto it = aliases_.begin(); it != aliases_.end();) {
+    if (it->second == entry)
+      it = aliases_.erase(it);
+    else
+      ++it;
   }
+  if (defaultEntry_ == entry)
+    defaultEntry_ = nullptr;
+  GlyphInfo *glyphs = entry->font.glyphs;
+  MemFree(entry->font.recs);
+  entries_.erase(glyphs); // Frees entry
+  MemFree(glyphs);
+}
 
-  Font font = LoadRobotoFont(weight, style, size);
-  if (font.texture.id != 0) {
-    fontCache_[key] = font;
+FontManager::FontEntry *FontManager::FindEntry(const GlyphInfo *glyphs) {
+  if (!glyphs)
+    return nullptr;
+  auto it = entries_.find(glyphs);
+  if (it != entries_.end())
+    return it->second.get();
+  auto alias = aliases_.find(glyphs);
+  return alias != aliases_.end() ? alias->second : nullptr;
+}
+
+int FontManager::AddGlyphSlot(FontEntry &entry, int codepoint) {
+  Font &font = entry.font;
+  if (font.glyphCount == entry.capacity) {
+    // Copies of the font handed out this frame may still point at the old
+    // arrays, so they are kept, resolving to this entry, until EndFrame().
+    int capacity = entry.capacity * 2;
+    GlyphInfo *glyphs = (GlyphInfo *)MemAlloc(capacity * sizeof(GlyphInfo));
+    Rectangle *recs = (Rectangle *)MemAlloc(capacity * sizeof(Rectangle));
+    memcpy(glyphs, font.glyphs, font.glyphCount * sizeof(GlyphInfo));
+    memcpy(recs, font.recs, font.glyphCount * sizeof(Rectangle));
+
+    auto node = entries_.extract(font.glyphs);
+    aliases_[font.glyphs] = &entry;
+    retired_.push_back({font.glyphs, font.recs});
+    font.glyphs = glyphs;
+    font.recs = recs;
+    entry.capacity = capacity;
+    node.key() = glyphs;
+    entries_.insert(std::move(node));
   }
 
-  return font;
+  int index = font.glyphCount++;
+  font.glyphs[index] = {};
+  font.glyphs[index].value = codepoint;
+  font.recs[index] = {0, 0, 0, 0};
+  entry.ready.push_back(false);
+  entry.extraIndex[codepoint] = index;
+  return index;
 }
 
-Font FontManager::LoadCustomFont(const std::string &path, int size) {
+void FontManager::InvalidateGlyphs(FontEntry &entry) {
+  std::fill(entry.ready.begin(), entry.ready.end(), false);
+  std::fill(entry.font.recs, entry.font.recs + entry.font.glyphCount,
+            Rectangle{0, 0, 0, 0});
+  entry.unpacked.clear();
+  entry.generation = GlyphAtlas::GetGeneration();
+  // Reading the cache file again beats rasterizing the glyphs again.
+  entry.diskChecked = false;
+}
+
+bool FontManager::StoreGlyph(FontEntry &entry, int index, GlyphInfo &glyph,
+                             bool mayReset) {
+  Font &font = entry.font;
+  font.glyphs[index].offsetX = glyph.offsetX;
+  font.glyphs[index].offsetY = glyph.offsetY;
+  font.glyphs[index].advanceX = glyph.advanceX;
+  Rectangle rec = {0, 0, (float)glyph.image.width, (float)glyph.image.height};
+
+  // Spaces are never drawn; their rect only serves as a fallback advance.
+  int codepoint = font.glyphs[index].value;
+  bool visible = codepoint != ' ' && codepoint != '\t' && glyph.image.data &&
+                 glyph.image.width > 0 && glyph.image.height > 0;
+  if (visible) {
+    if (glyph.image.format != PIXELFORMAT_UNCOMPRESSED_GRAYSCALE)
+      ImageFormat(&glyph.image, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE);
+    if (!GlyphAtlas::Add((const unsigned char *)glyph.image.data,
+                         glyph.image.width, glyph.image.height,
+                         glyph.image.width, kGlyphPadding, mayReset,
+                         &rec)) {
+      rec = {0, 0, 0, 0};
+      entry.unpacked.insert(index);
+      visible = false;
+    }
+  }
+  font.recs[index] = rec;
+  entry.ready[index] = true;
+  return visible;
+}
+
+std::vector<const FontManager::FontFace *>
+FontManager::FaceChain(const FontEntry &entry) {
+  std::vector<const FontFace *> chain(1, entry.face);
+  chain.insert(chain.end(), fallbackFaces_.begin(), fallbackFaces_.end());
+  return chain;
+}
+
+FontManager::GlyphBatch
+FontManager::LoadGlyphs(const std::vector<const FontFace *> &chain, int size,
+                        std::vector<int> codepoints) {
+  GlyphBatch batch;
+  batch.entryId = 0;
+  batch.fromDisk = false;
+  batch.glyphs.assign(codepoints.size(), GlyphInfo{});
+  batch.found.assign(codepoints.size(), false);
+  batch.fallback.assign(codepoints.size(), false);
+  batch.codepoints = std::move(codepoints);
+
+  // Indices into the batch still looking for a face.
+  std::vector<int> pending(batch.codepoints.size());
+  for (size_t i = 0; i < pending.size(); i++)
+    pending[i] = (int)i;
+  std::vector<int> request;
+  std::vector<int> unresolved;
+
+  // The font's own face first, then the fallbacks in order. The last face
+  // tried settles whatever is still unresolved.
+  for (size_t f = 0; f < chain.size() && !pending.empty(); f++) {
+    bool lastFace = f + 1 == chain.size();
+    request.clear();
+    for (int index : pending)
+      request.push_back(batch.codepoints[index]);
+    // LoadFontData() only reads the TTF tables it needs and renders just the
+    // requested codepoints.
+    GlyphInfo *glyphs =
+        LoadFontData(chain[f]->data, chain[f]->dataSize, size, request.data(),
+                     (int)request.size(), FONT_DEFAULT);
+
+    unresolved.clear();
+    for (size_t i = 0; i < pending.size(); i++) {
+      // raylib leaves codepoints the face has no outline for empty.
+      bool found = glyphs && (glyphs[i].advanceX != 0 ||
+                              (glyphs[i].image.data && glyphs[i].image.width));
+      if (!found && !lastFace) {
+        unresolved.push_back(pending[i]);
+        if (glyphs)
+          UnloadImage(glyphs[i].image);
+        continue;
+      }
+      if (glyphs)
+        batch.glyphs[pending[i]] = glyphs[i]; // Takes the image
+      batch.found[pending[i]] = found;
+      batch.fallback[pending[i]] = found && f > 0;
+    }
+    MemFree(glyphs);
+    pending.swap(unresolved);
+  }
+  return batch;
+}
+
+bool FontManager::AtlasInUse(const FontEntry &entry) {
+  for (const auto &[glyphs, other] : entries_) {
+    if (other.get() != &entry && other->usedFrame == frameCount_ &&
+        other->generation == GlyphAtlas::GetGeneration())
+      return true;
+  }
+  return false;
+}
+
+void FontManager::ApplyGlyphs(FontEntry &entry, GlyphBatch &batch) {
+  // A full atlas is cleared, dropping every font's glyphs, only while no
+  // other font has drawn from it this frame; otherwise the fonts sharing it
+  // would take turns clearing it. The batch is then packed again into the
+  // fresh atlas, without a second clear: glyphs that still do not fit stay
+  // unpacked until the atlas is next cleared.
+  bool mayReset = !AtlasInUse(entry);
+  for (int pass = 0; pass < 2; pass++) {
+    uint32_t generation = GlyphAtlas::GetGeneration();
+    for (size_t i = 0; i < batch.codepoints.size(); i++) {
+      if (GlyphAtlas::GetGeneration() != generation)
+        break;
+      int codepoint = batch.codepoints[i];
+      int index;
+      if (IsAscii(codepoint)) {
+        index = codepoint - kFirstCodepoint;
+      } else if (!batch.found[i]) {
+        entry.extraIndex[codepoint] = kMissingGlyph;
+        continue;
+      } else {
+        auto it = entry.extraIndex.find(codepoint);
+        index = it != entry.extraIndex.end() && it->second >= kGlyphCount
+                    ? it->second
+                    : AddGlyphSlot(entry, codepoint);
+      }
+      // Already rasterized on the main thread while this batch was pending.
+      if (entry.ready[index])
+        continue;
+      if (StoreGlyph(entry, index, batch.glyphs[i], mayReset && pass == 0) &&
+          !batch.fromDisk)
+        PerfCounters::Frame().fontRasterizations++;
+      if (batch.fallback[i])
+        entry.fallbackGlyphs.insert(codepoint);
+      else if (!batch.fromDisk)
+        entry.diskDirty = true;
+    }
+    if (GlyphAtlas::GetGeneration() == generation)
+      return;
+    InvalidateGlyphs(entry);
+  }
+}
+
+void FontManager::FreeGlyphBatch(GlyphBatch &batch) {
+  if (!batch.fromDisk) {
+    for (GlyphInfo &glyph : batch.glyphs)
+      UnloadImage(glyph.image);
+  }
+  batch.glyphs.clear();
+}
+
+void FontManager::RasterizeGlyphs(FontEntry &entry,
+                                  std::vector<int> codepoints) {
+  GlyphBatch batch =
+      LoadGlyphs(FaceChain(entry), entry.font.baseSize, std::move(codepoints));
+  ApplyGlyphs(entry, batch);
+  FreeGlyphBatch(batch);
+}
+
+uint64_t FontManager::FaceHash(const FontFace *face) {
+  // Hashed once, on first use, so faces that are never cached cost nothing.
+  if (face->hash == 0)
+    face->hash = FontAtlasCache::Hash(face->data, (size_t)face->dataSize);
+  return face->hash;
+}
+
+void FontManager::LoadCachedGlyphs(FontEntry &entry) {
+  if (FontAtlasCache::IsEnabled()) {
+    FontAtlasCache::Load(
+        FaceHash(entry.face), entry.font.baseSize,
+        [&entry](const std::vector<CachedGlyph> &cached) {
+          GlyphBatch batch;
+          batch.entryId = entry.id;
+          batch.fromDisk = true;
+          batch.found.assign(cached.size(), true);
+          batch.fallback.assign(cached.size(), false);
+          for (const CachedGlyph &glyph : cached) {
+            GlyphInfo info = {};
+            info.value = glyph.codepoint;
+            info.offsetX = glyph.offsetX;
+            info.offsetY = glyph.offsetY;
+            info.advanceX = glyph.advanceX;
+            // StoreGlyph() only reads grayscale images, so the mapping can
+            // be packed in place.
+            info.image = {(void *)glyph.pixels, glyph.width, glyph.height, 1,
+                          PIXELFORMAT_UNCOMPRESSED_GRAYSCALE};
+            batch.codepoints.push_back(glyph.codepoint);
+            batch.glyphs.push_back(info);
+          }
+          ApplyGlyphs(entry, batch);
+        });
+  }
+  entry.diskChecked = true;
+}
+
+void FontManager::SaveCachedGlyphs(FontEntry &entry) {
+  // Glyphs of an older atlas generation are gone from the atlas.
+  if (!entry.diskDirty || !FontAtlasCache::IsEnabled() ||
+      entry.generation != GlyphAtlas::GetGeneration())
+    return;
+
+  const Font &font = entry.font;
+  std::vector<CachedGlyph> glyphs;
+  std::vector<size_t> offsets;
+  std::vector<unsigned char> pixels;
+  std::unordered_set<int> saved;
+  for (int i = 0; i < font.glyphCount; i++) {
+    int codepoint = font.glyphs[i].value;
+    if (!entry.ready[i] || entry.fallbackGlyphs.count(codepoint) ||
+        entry.unpacked.count(i))
+      continue;
+    const Rectangle &rec = font.recs[i];
+    CachedGlyph glyph = {codepoint,
+                         font.glyphs[i].offsetX,
+                         font.glyphs[i].offsetY,
+                         font.glyphs[i].advanceX,
+                         (int)rec.width,
+                         (int)rec.height,
+                         nullptr};
+    // As in StoreGlyph(), spaces have a rect but nothing in the atlas.
+    bool packed = codepoint != ' ' && codepoint != '\t' && glyph.width > 0 &&
+                  glyph.height > 0;
+    offsets.push_back(packed ? pixels.size() : SIZE_MAX);
+    if (packed) {
+      pixels.resize(pixels.size() + (size_t)glyph.width * glyph.height);
+      GlyphAtlas::Read(rec, &pixels[offsets.back()]);
+    }
+    glyphs.push_back(glyph);
+    saved.insert(codepoint);
+  }
+
+  // Keep what the file has beyond this run's glyphs, e.g. after the atlas was
+  // reset and only some came back.
+  FontAtlasCache::Load(
+      FaceHash(entry.face), font.baseSize,
+      [&](const std::vector<CachedGlyph> &cached) {
+        for (const CachedGlyph &glyph : cached) {
+          if (saved.count(glyph.codepoint))
+            continue;
+          offsets.push_back(glyph.pixels ? pixels.size() : SIZE_MAX);
+          if (glyph.pixels)
+            pixels.insert(pixels.end(), glyph.pixels,
+                          glyph.pixels + (size_t)glyph.width * glyph.height);
+          glyphs.push_back(glyph);
+        }
+      });
+  // Pointed at the pixel copies only now that the buffer has stopped
+  // growing.
+  for (size_t i = 0; i < glyphs.size(); i++)
+    glyphs[i].pixels = offsets[i] == SIZE_MAX ? nullptr : &pixels[offsets[i]];
+
+  if (FontAtlasCache::Save(FaceHash(entry.face), font.baseSize, glyphs))
+    entry.diskDirty = false;
+}
+
+void FontManager::SaveGlyphCache() {
+  for (auto &[glyphs, entry] : entries_)
+    SaveCachedGlyphs(*entry);
+}
+
+void FontManager::MissingGlyphs(const FontEntry &entry, const char *text,
+                                std::vector<int> *missing) {
+  bool hasExtra = false;
+  for (int i = 0; text[i] != '\0';) {
+    int byteCount = 0;
+    int codepoint = GetCodepointNext(&text[i], &byteCount);
+    i += byteCount;
+    if (codepoint == '\n')
+      continue;
+
+    int index;
+    if (IsAscii(codepoint)) {
+      index = codepoint - kFirstCodepoint;
+    } else {
+      hasExtra = true;
+      auto it = entry.extraIndex.find(codepoint);
+      if (it == entry.extraIndex.end()) {
+        missing->push_back(codepoint);
+        continue;
+      }
+      index = it->second;
+    }
+    if (!entry.ready[index])
+      missing->push_back(entry.font.glyphs[index].value);
+  }
+  // Codepoints no face has are drawn with '?'.
+  if (hasExtra && !entry.ready[kMissingGlyph])
+    missing->push_back('?');
+
+  if (!missing->empty()) {
+    std::sort(missing->begin(), missing->end());
+    missing->erase(std::unique(missing->begin(), missing->end()),
+                   missing->end());
+  }
+}
+
+FontManager::FontEntry *FontManager::FindSubstitute(const FontEntry &entry,
+                                                    const char *text) {
+  FontEntry *best = nullptr;
+  int bestScore = INT_MAX;
+  std::vector<int> missing;
+  for (auto &[glyphs, candidate] : entries_) {
+    if (candidate.get() == &entry ||
+        candidate->generation != GlyphAtlas::GetGeneration())
+      continue;
+    // Nearest size, preferring the same face (weight).
+    int score = std::abs(candidate->font.baseSize - entry.font.baseSize);
+    if (candidate->face != entry.face)
+      score += 1000;
+    if (score >= bestScore)
+      continue;
+    missing.clear();
+    MissingGlyphs(*candidate, text, &missing);
+    if (missing.empty()) {
+      best = candidate.get();
+      bestScore = score;
+    }
+  }
+  return best;
+}
+
+void FontManager::EnsureGlyphs(Font &font, const char *text) {
+  FontEntry *entry = FindEntry(font.glyphs);
+  if (!entry)
+    return;
+  if (entry->generation != GlyphAtlas::GetGeneration())
+    InvalidateGlyphs(*entry);
+  if (!entry->diskChecked)
+    LoadCachedGlyphs(*entry);
+
+  // Stays unallocated unless something is missing.
+  std::vector<int> missing;
+  if (text)
+    MissingGlyphs(*entry, text, &missing);
+  if (!missing.empty()) {
+    FontEntry *substitute =
+        IsAsyncGlyphsEnabled() ? FindSubstitute(*entry, text) : nullptr;
+    if (substitute) {
+      QueueGlyphs(*entry, missing);
+      entry = substitute;
+    } else {
+      RasterizeGlyphs(*entry, std::move(missing));
+    }
+  }
+
+  // Also picks up a texture replaced by another font's glyphs growing the
+  // atlas.
+  entry->font.texture = GlyphAtlas::GetTexture();
+  entry->usedFrame = frameCount_;
+  font = entry->font;
+}
+
+bool FontManager::QueueGlyphs(FontEntry &entry,
+                              const std::vector<int> &codepoints) {
+#if RAYM3_ASYNC_FONTS
+  GlyphJob job;
+  for (int codepoint : codepoints) {
+    if (entry.queued.insert(codepoint).second)
+      job.codepoints.push_back(codepoint);
+  }
+  if (job.codepoints.empty())
+    return false;
+  job.entryId = entry.id;
+  job.chain = FaceChain(entry);
+  job.size = entry.font.baseSize;
+
+  {
+    std::lock_guard<std::mutex> lock(jobMutex_);
+    jobs_.push_back(std::move(job));
+    jobsInFlight_++;
+  }
+  if (workers_.empty()) {
+    // Sizes are independent jobs, so a prewarm spreads across cores; keep
+    // one for the UI thread.
+    int count = (int)std::thread::hardware_concurrency() - 1;
+    count = std::clamp(count, 1, 4);
+    for (int i = 0; i < count; i++)
+      workers_.emplace_back(WorkerLoop);
+  }
+  jobReady_.notify_one();
+  return true;
+#else
+  RasterizeGlyphs(entry, codepoints);
+  return false;
+#endif
+}
+
+void FontManager::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(jobMutex_);
+  while (true) {
+    jobReady_.wait(lock, [] { return stopWorkers_ || !jobs_.empty(); });
+    if (stopWorkers_)
+      return;
+    GlyphJob job = std::move(jobs_.front());
+    jobs_.pop_front();
+
+    lock.unlock();
+    GlyphBatch batch =
+        LoadGlyphs(job.chain, job.size, std::move(job.codepoints));
+    batch.entryId = job.entryId;
+    lock.lock();
+    finished_.push_back(std::move(batch));
+  }
+}
+
+void FontManager::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(jobMutex_);
+    stopWorkers_ = true;
+  }
+  jobReady_.notify_all();
+  for (std::thread &worker : workers_)
+    worker.join();
+  workers_.clear();
+
+  for (GlyphBatch &batch : finished_)
+    FreeGlyphBatch(batch);
+  finished_.clear();
+  jobs_.clear();
+  jobsInFlight_ = 0;
+  stopWorkers_ = false;
+}
+
+void FontManager::BeginFrame() {
+  std::vector<GlyphBatch> finished;
+  {
+    std::lock_guard<std::mutex> lock(jobMutex_);
+    if (finished_.empty())
+      return;
+    finished.swap(finished_);
+    jobsInFlight_ -= (int)finished.size();
+  }
+
+  for (GlyphBatch &batch : finished) {
+    FontEntry *entry = nullptr;
+    for (auto &[glyphs, candidate] : entries_) {
+      if (candidate->id == batch.entryId)
+        entry = candidate.get();
+    }
+    // The font may have been unloaded meanwhile.
+    if (entry) {
+      for (int codepoint : batch.codepoints)
+        entry->queued.erase(codepoint);
+      if (entry->generation != GlyphAtlas::GetGeneration())
+        InvalidateGlyphs(*entry);
+      ApplyGlyphs(*entry, batch);
+    }
+    FreeGlyphBatch(batch);
+  }
+}
+
+void FontManager::SetAsyncGlyphs(bool enabled) { asyncGlyphs_ = enabled; }
+
+bool FontManager::IsAsyncGlyphsEnabled() {
+#if RAYM3_ASYNC_FONTS
+  return asyncGlyphs_;
+#else
+  return false;
+#endif
+}
+
+int FontManager::GetPendingGlyphJobs() {
+  std::lock_guard<std::mutex> lock(jobMutex_);
+  return jobsInFlight_;
+}
+
+int FontManager::GetRasterizingGlyphJobs() {
+  std::lock_guard<std::mutex> lock(jobMutex_);
+  return jobsInFlight_ - (int)finished_.size();
+}
+
+int FontManager::Prewarm(FontWeight weight, const std::vector<float> &sizes) {
+  if (UseSdf()) {
+    // Distance-field fonts bake all of ASCII at once.
+    bool bold = weight == FontWeight::Bold || weight == FontWeight::Black;
+    LoadSdfFont(bold ? &boldFace_ : &regularFace_);
+    return 0;
+  }
+
+  int queued = 0;
+  std::vector<int> missing;
+  for (float size : sizes) {
+    FontEntry *entry = GetEntry(weight, FontStyle::Normal, (int)size);
+    if (entry->generation != GlyphAtlas::GetGeneration())
+      InvalidateGlyphs(*entry);
+    if (!entry->diskChecked)
+      LoadCachedGlyphs(*entry);
+    missing.clear();
+    for (int i = 0; i < kGlyphCount; i++) {
+      if (!entry->ready[i])
+        missing.push_back(kFirstCodepoint + i);
+    }
+    if (missing.empty())
+      continue;
+    if (IsAsyncGlyphsEnabled()) {
+      if (QueueGlyphs(*entry, missing))
+        queued++;
+    } else {
+      RasterizeGlyphs(*entry, missing);
+    }
+  }
+  return queued;
+}
+
+int FontManager::GetGlyphIndex(const Font &font, int codepoint) {
+  // FontManager fonts, SDF ones included, start with printable ASCII.
+  int ascii = codepoint - kFirstCodepoint;
+  if (ascii >= 0 && ascii < kGlyphCount && ascii < font.glyphCount &&
+      font.glyphs[ascii].value == codepoint)
+    return ascii;
+
+  FontEntry *entry = FindEntry(font.glyphs);
+  if (!entry)
+    return ::GetGlyphIndex(font, codepoint);
+  auto it = entry->extraIndex.find(codepoint);
+  if (it == entry->extraIndex.end() || it->second >= font.glyphCount)
+    return kMissingGlyph;
+  return it->second;
+}
+
+uint64_t FontManager::GetFontId(const Font &font) {
+  // Entry ids count up from 1; other fonts are told apart by their glyph
+  // array, which no small id can collide with.
+  FontEntry *entry = FindEntry(font.glyphs);
+  return entry ? entry->id : (uint64_t)(uintptr_t)font.glyphs;
+}
+
+const FontManager::FontFace *FontManager::LoadFace(const std::string &path) {
   std::string resolvedPath = path;
-  
+
   if (!std::filesystem::path(path).is_absolute()) {
     std::vector<std::string> searchPaths = {
       std::string(RAYM3_RESOURCE_DIR) + "/fonts/" + path,
@@ -60,7 +750,7 @@ Font FontManager::LoadCustomFont(const std::string &path, int size) {
       "./raym3/resources/fonts/" + path,
       path
     };
-    
+
     for (const auto& testPath : searchPaths) {
       if (std::filesystem::exists(testPath)) {
         resolvedPath = testPath;
@@ -68,37 +758,171 @@ Font FontManager::LoadCustomFont(const std::string &path, int size) {
       }
     }
   }
-  
-  if (!std::filesystem::exists(resolvedPath)) {
+
+  auto face = customFaces_.find(resolvedPath);
+  if (face == customFaces_.end()) {
+    if (!std::filesystem::exists(resolvedPath)) {
+      return nullptr;
+    }
+
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(resolvedPath.c_str(), &dataSize);
+    if (!data) {
+      return nullptr;
+    }
+    auto loaded = std::make_unique<FontFace>();
+    loaded->owned.assign(data, data + dataSize);
+    loaded->data = loaded->owned.data();
+    loaded->dataSize = dataSize;
+    UnloadFileData(data);
+    face = customFaces_.emplace(resolvedPath, std::move(loaded)).first;
+  }
+  return face->second.get();
+}
+
+bool FontManager::AddFallbackFont(const std::string &path) {
+  const FontFace *face = LoadFace(path);
+  if (!face)
+    return false;
+  if (std::find(fallbackFaces_.begin(), fallbackFaces_.end(), face) ==
+      fallbackFaces_.end())
+    fallbackFaces_.push_back(face);
+
+  // Codepoints no face had were mapped to '?'; look them up again.
+  for (auto &[glyphs, entry] : entries_) {
+    for (auto it = entry->extraIndex.begin();
+         it != entry->extraIndex.end();) {
+      if (it->second == kMissingGlyph)
+        it = entry->extraIndex.erase(it);
+      else
+        ++it;
+    }
+  }
+  TextMeasureCache::Clear();
+  TextLayout::Clear();
+  return true;
+}
+
+bool FontManager::UseSdf() {
+  return sdfEnabled_ && RenderBackend::Get()->SupportsSdfText();
+}
+
+bool FontManager::IsSdfFont(const Font &font) {
+  if (!font.glyphs)
+    return false;
+  for (const auto &[face, sdf] : sdfFonts_) {
+    if (sdf.glyphs == font.glyphs)
+      return true;
+  }
+  return false;
+}
+
+Font FontManager::LoadSdfFont(const FontFace *face) {
+  auto it = sdfFonts_.find(face);
+  if (it != sdfFonts_.end()) {
+    PerfCounters::Frame().fontCacheHits++;
+    return it->second;
+  }
+  PerfCounters::Frame().fontCacheMisses++;
+
+  Font font = {0};
+  font.baseSize = kSdfBaseSize;
+  font.glyphCount = kGlyphCount;
+  font.glyphPadding = kGlyphPadding;
+  font.glyphs = LoadFontData(face->data, face->dataSize, kSdfBaseSize, nullptr,
+                             kGlyphCount, FONT_SDF);
+  if (!font.glyphs)
+    return {0};
+
+  Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, kGlyphCount,
+                                  kSdfBaseSize, kGlyphPadding, 1);
+  RenderBackend *backend = RenderBackend::Get();
+  font.texture = backend->LoadTexture(atlas);
+  UnloadImage(atlas);
+  if (font.texture.id == 0) {
+    UnloadFontData(font.glyphs, font.glyphCount);
+    MemFree(font.recs);
     return {0};
   }
+  // The field is interpolated between texels; nearest sampling would show
+  // the texel grid when scaled up.
+  backend->SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+  PerfCounters::Frame().fontRasterizations += kGlyphCount;
 
-  Font font = LoadFontEx(resolvedPath.c_str(), size, nullptr, 0);
+  sdfFonts_[face] = font;
   return font;
 }
 
-void FontManager::UnloadFont(Font font) {
-  if (font.texture.id != 0) {
-    ::UnloadFont(font);
+FontManager::FontEntry *FontManager::GetEntry(FontWeight weight,
+                                              FontStyle style, int size) {
+  // Weights share the face they are drawn with, and so their glyphs.
+  bool bold = weight == FontWeight::Bold || weight == FontWeight::Black;
+  FontKey key{bold ? FontWeight::Bold : FontWeight::Regular, style, size};
+
+  auto it = fontCache_.find(key);
+  if (it != fontCache_.end()) {
+    PerfCounters::Frame().fontCacheHits++;
+    return it->second;
   }
+  PerfCounters::Frame().fontCacheMisses++;
+  FontEntry *entry = CreateEntry(bold ? &boldFace_ : &regularFace_, size);
+  fontCache_[key] = entry;
+  return entry;
 }
 
-Font FontManager::LoadRobotoFont(FontWeight weight, FontStyle style, int size) {
-  // Map weights to available embedded fonts
-  unsigned char *fontData = nullptr;
-  unsigned int fontDataLen = 0;
+Font FontManager::LoadFont(FontWeight weight, FontStyle style, int size) {
+  if (PrewarmManifest::IsRecording())
+    PrewarmManifest::RecordFont(weight, size);
+  if (UseSdf()) {
+    bool bold = weight == FontWeight::Bold || weight == FontWeight::Black;
+    Font sdf = LoadSdfFont(bold ? &boldFace_ : &regularFace_);
+    if (sdf.texture.id != 0)
+      return sdf;
+  }
+
+  FontEntry *entry = GetEntry(weight, style, size);
+  entry->font.texture = GlyphAtlas::GetTexture();
+  return entry->font;
+}
 
-  if (weight == FontWeight::Bold || weight == FontWeight::Black) {
-    fontData = Roboto_v3_012_hinted_static_Roboto_Bold_ttf;
-    fontDataLen = Roboto_v3_012_hinted_static_Roboto_Bold_ttf_len;
-  } else {
-    fontData = Roboto_v3_012_hinted_static_Roboto_Regular_ttf;
-    fontDataLen = Roboto_v3_012_hinted_static_Roboto_Regular_ttf_len;
+Font FontManager::LoadCustomFont(const std::string &path, int size) {
+  const FontFace *face = LoadFace(path);
+  if (!face)
+    return {0};
+
+  if (UseSdf()) {
+    Font sdf = LoadSdfFont(face);
+    if (sdf.texture.id != 0)
+      return sdf;
   }
+  return CreateEntry(face, size)->font;
+}
 
-  Font font =
-      LoadFontFromMemory(".ttf", fontData, fontDataLen, size, nullptr, 0);
-  return font;
+void FontManager::UnloadFont(Font font) {
+  // Distance-field fonts are shared by every size; Shutdown() frees them.
+  if (IsSdfFont(font))
+    return;
+  TextMeasureCache::Clear();
+  TextLayout::Clear();
+
+  if (FontEntry *entry = FindEntry(font.glyphs)) {
+    DestroyEntry(entry);
+    return;
+  }
+
+  // A font loaded elsewhere (e.g. raylib's LoadFont()).
+  if (font.texture.id != 0) {
+    UnloadFontData(font.glyphs, font.glyphCount);
+    RenderBackend::Get()->UnloadTexture(font.texture);
+    MemFree(font.recs);
+  }
+}
+
+Font FontManager::GetDefaultFont() {
+  if (!defaultEntry_)
+    return {0};
+  defaultEntry_->font.texture = GlyphAtlas::GetTexture();
+  return defaultEntry_->font;
 }
 
 } // namespace raym3
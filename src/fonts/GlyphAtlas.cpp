@@ -0,0 +1,231 @@
+#include "raym3/fonts/GlyphAtlas.h"
+#include "raym3/rendering/RenderBackend.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace raym3 {
+
+// Width is fixed so growing only appends rows; 1024 fits a full ASCII set of
+// a 57px font on one shelf.
+static constexpr int kAtlasWidth = 1024;
+static constexpr int kInitialHeight = 256;
+static constexpr int kMaxHeight = 4096;
+
+int GlyphAtlas::width_ = 0;
+int GlyphAtlas::height_ = 0;
+std::vector<unsigned char> GlyphAtlas::pixels_;
+std::vector<GlyphAtlas::SkylineNode> GlyphAtlas::skyline_;
+Texture2D GlyphAtlas::texture_ = {0};
+std::vector<Texture2D> GlyphAtlas::retired_;
+int GlyphAtlas::dirtyTop_ = INT_MAX;
+int GlyphAtlas::dirtyBottom_ = 0;
+int GlyphAtlas::packedArea_ = 0;
+uint32_t GlyphAtlas::generation_ = 0;
+GlyphAtlasStats GlyphAtlas::stats_;
+
+// Y at which a width x height rect can sit with its left edge on skyline
+// node `index`, or -1 if it does not fit.
+int GlyphAtlas::Fit(size_t index, int width, int height) {
+  int x = skyline_[index].x;
+  if (x + width > width_)
+    return -1;
+  int y = skyline_[index].y;
+  int remaining = width;
+  for (size_t i = index; remaining > 0; i++) {
+    y = std::max(y, skyline_[i].y);
+    if (y + height > height_)
+      return -1;
+    remaining -= skyline_[i].width;
+  }
+  return y;
+}
+
+// Bottom-left skyline: lowest position first, then the narrowest node.
+bool GlyphAtlas::Pack(int width, int height, int *x, int *y) {
+  size_t best = SIZE_MAX;
+  int bestY = INT_MAX;
+  int bestWidth = INT_MAX;
+  for (size_t i = 0; i < skyline_.size(); i++) {
+    int fitY = Fit(i, width, height);
+    if (fitY < 0)
+      continue;
+    if (fitY + height < bestY ||
+        (fitY + height == bestY && skyline_[i].width < bestWidth)) {
+      best = i;
+      bestY = fitY + height;
+      bestWidth = skyline_[i].width;
+    }
+  }
+  if (best == SIZE_MAX)
+    return false;
+
+  *x = skyline_[best].x;
+  *y = bestY - height;
+  skyline_.insert(skyline_.begin() + best, {*x, bestY, width});
+
+  // Trim the nodes now covered by the new one.
+  for (size_t i = best + 1; i < skyline_.size();) {
+    const SkylineNode &prev = skyline_[i - 1];
+    int overlap = prev.x + prev.width - skyline_[i].x;
+    if (overlap <= 0)
+      break;
+    skyline_[i].x += overlap;
+    skyline_[i].width -= overlap;
+    if (skyline_[i].width > 0)
+      break;
+    skyline_.erase(skyline_.begin() + i);
+  }
+  for (size_t i = 0; i + 1 < skyline_.size();) {
+    if (skyline_[i].y == skyline_[i + 1].y) {
+      skyline_[i].width += skyline_[i + 1].width;
+      skyline_.erase(skyline_.begin() + i + 1);
+    } else {
+      i++;
+    }
+  }
+  return true;
+}
+
+void GlyphAtlas::RetireTexture() {
+  if (texture_.id != 0)
+    retired_.push_back(texture_);
+  texture_ = {0};
+}
+
+bool GlyphAtlas::Grow() {
+  if (height_ >= kMaxHeight)
+    return false;
+  size_t oldSize = pixels_.size();
+  height_ *= 2;
+  pixels_.resize((size_t)width_ * height_ * 2, 0);
+  for (size_t i = oldSize; i < pixels_.size(); i += 2)
+    pixels_[i] = 255;
+  RetireTexture();
+  stats_.grows++;
+  return true;
+}
+
+void GlyphAtlas::Reset() {
+  bool first = width_ == 0;
+  width_ = kAtlasWidth;
+  height_ = kInitialHeight;
+  // White with zero alpha; glyph coverage goes in the alpha channel.
+  pixels_.assign((size_t)width_ * height_ * 2, 0);
+  for (size_t i = 0; i < pixels_.size(); i += 2)
+    pixels_[i] = 255;
+  skyline_.assign(1, {0, 0, width_});
+  packedArea_ = 0;
+  dirtyTop_ = INT_MAX;
+  dirtyBottom_ = 0;
+  RetireTexture();
+  stats_.glyphs = 0;
+  if (!first) {
+    generation_++;
+    stats_.resets++;
+  }
+}
+
+bool GlyphAtlas::Add(const unsigned char *coverage, int width, int height,
+                     int stride, int padding, bool mayReset,
+                     Rectangle *rect) {
+  if (width_ == 0)
+    Reset();
+  int paddedW = width + 2 * padding;
+  int paddedH = height + 2 * padding;
+  if (paddedW > width_ || paddedH > kMaxHeight) {
+    stats_.rejected++;
+    return false;
+  }
+
+  int x = 0, y = 0;
+  while (!Pack(paddedW, paddedH, &x, &y)) {
+    if (!Grow()) {
+      if (stats_.glyphs == 0 || !mayReset) {
+        stats_.rejected++;
+        return false;
+      }
+      Reset();
+    }
+  }
+
+  // The slot is already transparent; only the bitmap is copied in.
+  for (int row = 0; row < height; row++) {
+    unsigned char *dst =
+        &pixels_[((size_t)(y + padding + row) * width_ + x + padding) * 2];
+    const unsigned char *src = coverage + (size_t)row * stride;
+    for (int col = 0; col < width; col++)
+      dst[col * 2 + 1] = src[col];
+  }
+  dirtyTop_ = std::min(dirtyTop_, y);
+  dirtyBottom_ = std::max(dirtyBottom_, y + paddedH);
+
+  packedArea_ += paddedW * paddedH;
+  stats_.glyphs++;
+  *rect = {(float)(x + padding), (float)(y + padding), (float)width,
+           (float)height};
+  return true;
+}
+
+void GlyphAtlas::Read(Rectangle rect, unsigned char *coverage) {
+  int x = (int)rect.x, y = (int)rect.y;
+  int width = (int)rect.width, height = (int)rect.height;
+  for (int row = 0; row < height; row++) {
+    const unsigned char *src =
+        &pixels_[((size_t)(y + row) * width_ + x) * 2];
+    for (int col = 0; col < width; col++)
+      coverage[(size_t)row * width + col] = src[col * 2 + 1];
+  }
+}
+
+Texture2D GlyphAtlas::GetTexture() {
+  if (width_ == 0)
+    return {0};
+
+  RenderBackend *backend = RenderBackend::Get();
+  if (texture_.id == 0) {
+    Image image = {.data = pixels_.data(),
+                   .width = width_,
+                   .height = height_,
+                   .mipmaps = 1,
+                   .format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA};
+    texture_ = backend->LoadTexture(image);
+    dirtyTop_ = INT_MAX;
+    dirtyBottom_ = 0;
+  } else if (dirtyTop_ < dirtyBottom_) {
+    // Whole rows are contiguous in the mirror, so no staging copy is needed.
+    Rectangle region = {0, (float)dirtyTop_, (float)width_,
+                        (float)(dirtyBottom_ - dirtyTop_)};
+    backend->UpdateTexture(texture_, region,
+                           &pixels_[(size_t)dirtyTop_ * width_ * 2]);
+    dirtyTop_ = INT_MAX;
+    dirtyBottom_ = 0;
+    stats_.uploads++;
+  }
+
+  stats_.width = width_;
+  stats_.height = height_;
+  stats_.usage = (float)packedArea_ / ((float)width_ * height_);
+  return texture_;
+}
+
+void GlyphAtlas::EndFrame() {
+  for (const Texture2D &texture : retired_)
+    RenderBackend::Get()->UnloadTexture(texture);
+  retired_.clear();
+}
+
+void GlyphAtlas::Shutdown() {
+  RetireTexture();
+  EndFrame();
+  pixels_.clear();
+  pixels_.shrink_to_fit();
+  skyline_.clear();
+  width_ = 0;
+  height_ = 0;
+  packedArea_ = 0;
+  generation_++;
+  stats_ = {};
+}
+
+} // namespace raym3
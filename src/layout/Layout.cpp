@@ -1,6 +1,8 @@
 #include "raym3/layout/Layout.h"
 #include "raym3/components/TabBar.h"
 #include "raym3/raym3.h"
+#include "raym3/rendering/PerfCounters.h"
+#include "raym3/rendering/Renderer.h"
 #include <map>
 #include <string>
 #include <vector>
@@ -15,6 +17,19 @@
 
 namespace raym3 {
 
+// Yoga entry points, counted in PerfCounters.
+static YGNodeRef NewNode() {
+  PerfCounters::Frame().layoutNodes++;
+  return YGNodeNew();
+}
+
+static void CalculateLayout(YGNodeRef root) {
+  PerfStats &perf = PerfCounters::Frame();
+  perf.layoutPasses++;
+  PerfTimer timer(perf.layoutMs);
+  YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+}
+
 struct LayoutNodeInfo {
   YGNodeRef node = nullptr;
   Rectangle cachedBounds = {0, 0, 0, 0};
@@ -89,7 +104,7 @@ struct Layout::Impl {
     childCounter = 0;
 
     // Create root
-    root = YGNodeNew();
+    root = NewNode();
     YGNodeStyleSetWidth(root, rootBounds.width);
     YGNodeStyleSetHeight(root, rootBounds.height);
 
@@ -113,7 +128,7 @@ struct Layout::Impl {
       return;
 
     // Calculate layout
-    YGNodeCalculateLayout(root, YGUndefined, YGUndefined, YGDirectionLTR);
+    CalculateLayout(root);
 
     // Traverse and store bounds for next frame
     StoreCalculatedBounds(root, 0, 0);
@@ -270,7 +285,7 @@ static void ApplyStyle(YGNodeRef node, LayoutStyle style) {
 }
 
 Rectangle Layout::BeginContainer(LayoutStyle style) {
-  YGNodeRef node = YGNodeNew();
+  YGNodeRef node = NewNode();
   ApplyStyle(node, style);
   
   // Generate stable ID
@@ -334,7 +349,7 @@ void Layout::EndContainer() {
 }
 
 Rectangle Layout::Alloc(LayoutStyle style) {
-  YGNodeRef node = YGNodeNew();
+  YGNodeRef node = NewNode();
   ApplyStyle(node, style);
   
   // Generate stable ID
@@ -404,7 +419,7 @@ void Layout::End() {
   if (!impl_->root)
     return;
 
-  YGNodeCalculateLayout(impl_->root, YGUndefined, YGUndefined, YGDirectionLTR);
+  CalculateLayout(impl_->root);
 
   impl_->currentFrameBounds.clear();
 
@@ -493,7 +508,7 @@ void Layout::End() {
 Rectangle Layout::BeginScrollContainer(LayoutStyle style, bool scrollX,
                                        bool scrollY) {
   // Create the container node
-  YGNodeRef node = YGNodeNew();
+  YGNodeRef node = NewNode();
   ApplyStyle(node, style);
   
   // Generate stable ID
@@ -713,8 +728,8 @@ void Layout::DrawDebug() {
                       (unsigned char)(baseColor.b * 0.5f), 255};
     }
 
-    DrawRectangleRec(rect, fillColor);
-    DrawRectangleLinesEx(rect, 1.0f, outlineColor);
+    Renderer::DrawRectangle(rect, fillColor);
+    Renderer::DrawRectangleLines(rect, 1.0f, outlineColor);
   }
 }
 
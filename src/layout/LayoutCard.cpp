@@ -1,5 +1,7 @@
 #include "raym3/layout/LayoutCard.h"
 #include "raym3/raym3.h"
+#include "raym3/rendering/Renderer.h"
+#include <algorithm>
 
 namespace raym3 {
 
@@ -34,24 +36,24 @@ Rectangle LayoutCard::BeginCard(LayoutStyle style, CardVariant variant) {
       break;
     }
 
+    // Corner radius equivalent to a 0.15 raylib roundness
+    float cornerRadius = std::min(bounds.width, bounds.height) * 0.075f;
+
     // Draw shadow for elevated cards
     if (elevation > 0) {
       Color shadowColor = {0, 0, 0, 30};
-      DrawRectangleRounded(
-          {bounds.x + 2, bounds.y + 2, bounds.width, bounds.height}, 0.15f, 10,
-          shadowColor);
+      Renderer::DrawRoundedRectangle(
+          {bounds.x + 2, bounds.y + 2, bounds.width, bounds.height},
+          cornerRadius, shadowColor);
     }
 
     // Draw card background
-    DrawRectangleRounded(bounds, 0.15f, 10, cardColor);
+    Renderer::DrawRoundedRectangle(bounds, cornerRadius, cardColor);
 
     // Draw outline for outlined variant
     if (variant == CardVariant::Outlined) {
-#ifdef PLATFORM_ANDROID
-      DrawRectangleRoundedLinesEx(bounds, 0.15f, 10, 1.0f, scheme.outlineVariant);
-#else
-      DrawRectangleRoundedLines(bounds, 0.15f, 10, scheme.outlineVariant);
-#endif
+      Renderer::DrawRoundedRectangleEx(bounds, cornerRadius,
+                                       scheme.outlineVariant, 1.0f);
     }
   }
 
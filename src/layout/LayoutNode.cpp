@@ -1,4 +1,5 @@
 #include "raym3/layout/LayoutNode.h"
+#include "raym3/rendering/PerfCounters.h"
 
 #if RAYM3_USE_YOGA
 #include <yoga/YGNodeStyle.h>
@@ -11,6 +12,7 @@ namespace raym3 {
 LayoutNode::LayoutNode() {
 #if RAYM3_USE_YOGA
     node_ = YGNodeNew();
+    PerfCounters::Frame().layoutNodes++;
 #else
     node_ = nullptr;
     bounds_ = {0, 0, 0, 0};
@@ -258,6 +260,9 @@ void LayoutNode::RemoveAllChildren() {
 
 void LayoutNode::CalculateLayout(float width, float height) {
 #if RAYM3_USE_YOGA
+    PerfStats &perf = PerfCounters::Frame();
+    perf.layoutPasses++;
+    PerfTimer timer(perf.layoutMs);
     YGNodeCalculateLayout(node_, width, height, YGDirectionLTR);
 #else
     bounds_.width = width;
@@ -20,6 +20,17 @@
 #include "raym3/components/RadioButton.h"
 #include "raym3/components/SegmentedButton.h"
 #include "raym3/components/Text.h"
+#include "raym3/fonts/FontAtlasCache.h"
+#include "raym3/fonts/FontManager.h"
+#include "raym3/fonts/GlyphAtlas.h"
+#include "raym3/rendering/DamageTracker.h"
+#include "raym3/rendering/DrawCommandBuffer.h"
+#include "raym3/rendering/PerfCounters.h"
+#include "raym3/rendering/PrewarmManifest.h"
+#include "raym3/rendering/RenderBackend.h"
+#include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/SdfRenderer.h"
+#include "raym3/rendering/ShadowCache.h"
 #include "raym3/rendering/SvgRenderer.h"
 #include <algorithm>
 #include <cmath>
@@ -45,8 +56,8 @@ static Rectangle IntersectAndClampScissor(Rectangle requested, Rectangle current
   float bottom = std::min(requested.y + requested.height, current.y + current.height);
   if (right <= left || bottom <= top)
     return {0, 0, 0, 0};
-  int renderW = std::max(1, GetScreenWidth());
-  int renderH = std::max(1, GetScreenHeight());
+  int renderW = std::max(1, RenderBackend::Get()->GetScreenWidth());
+  int renderH = std::max(1, RenderBackend::Get()->GetScreenHeight());
   int x = (int)std::floor(left);
   int y = (int)std::floor(top);
   int w = (int)std::ceil(right - left);
@@ -61,8 +72,8 @@ static Rectangle IntersectAndClampScissor(Rectangle requested, Rectangle current
 }
 
 void PushScissor(Rectangle bounds) {
-  int renderW = std::max(1, GetScreenWidth());
-  int renderH = std::max(1, GetScreenHeight());
+  int renderW = std::max(1, RenderBackend::Get()->GetScreenWidth());
+  int renderH = std::max(1, RenderBackend::Get()->GetScreenHeight());
   Rectangle current = s_scissorStack.empty()
     ? Rectangle{0, 0, (float)renderW, (float)renderH}
     : s_scissorStack.back();
@@ -70,7 +81,7 @@ void PushScissor(Rectangle bounds) {
   if (applied.width < 1 || applied.height < 1)
     return;
   s_scissorStack.push_back(applied);
-  BeginScissorMode((int)applied.x, (int)applied.y, (int)applied.width, (int)applied.height);
+  DrawCommandBuffer::SetScissor(applied);
   if (s_scissorDebugEnabled)
     s_scissorDebugRects.push_back(applied);
 }
@@ -80,17 +91,16 @@ void PopScissor() {
     return;
   s_scissorStack.pop_back();
   if (s_scissorStack.empty()) {
-    EndScissorMode();
+    DrawCommandBuffer::ClearScissor();
     return;
   }
-  Rectangle prev = s_scissorStack.back();
-  BeginScissorMode((int)prev.x, (int)prev.y, (int)prev.width, (int)prev.height);
+  DrawCommandBuffer::SetScissor(s_scissorStack.back());
 }
 
 Rectangle GetCurrentScissorBounds() {
   if (s_scissorStack.empty()) {
-    int w = std::max(1, GetScreenWidth());
-    int h = std::max(1, GetScreenHeight());
+    int w = std::max(1, RenderBackend::Get()->GetScreenWidth());
+    int h = std::max(1, RenderBackend::Get()->GetScreenHeight());
     return {0, 0, (float)w, (float)h};
   }
   return s_scissorStack.back();
@@ -102,6 +112,68 @@ bool IsScissorDebug() { return s_scissorDebugEnabled; }
 void BeginScissor(Rectangle bounds) {
   PushScissor(bounds);
 }
+
+void SetDrawBatching(bool enabled) { DrawCommandBuffer::SetEnabled(enabled); }
+bool IsDrawBatching() { return DrawCommandBuffer::IsEnabled(); }
+void FlushDrawBatch() { DrawCommandBuffer::Flush(); }
+
+void SetSdfShapes(bool enabled) { Renderer::SetSdfShapes(enabled); }
+bool IsSdfShapesEnabled() { return Renderer::IsSdfShapesEnabled(); }
+
+void SetSdfText(bool enabled) { FontManager::SetSdfEnabled(enabled); }
+bool IsSdfTextEnabled() { return FontManager::IsSdfEnabled(); }
+
+void SetSdfIcons(bool enabled) { SvgRenderer::SetSdfEnabled(enabled); }
+bool IsSdfIconsEnabled() { return SvgRenderer::IsSdfEnabled(); }
+
+void PrewarmFonts(FontWeight weight) {
+  const TypographyScale &type = Theme::GetTypographyScale();
+  FontManager::Prewarm(
+      weight, {type.displayLarge, type.displayMedium, type.displaySmall,
+               type.headlineLarge, type.headlineMedium, type.headlineSmall,
+               type.titleLarge, type.titleMedium, type.titleSmall,
+               type.labelLarge, type.labelMedium, type.labelSmall,
+               type.bodyLarge, type.bodyMedium, type.bodySmall});
+}
+
+bool PrewarmFromManifest(const char *path, const PrewarmCallback &progress) {
+  PrewarmManifest manifest;
+  if (!manifest.Load(path))
+    return false;
+  manifest.Bake(progress);
+  return true;
+}
+
+void StartPrewarmRecording() { PrewarmManifest::StartRecording(); }
+
+bool SavePrewarmRecording(const char *path) {
+  return PrewarmManifest::GetRecording().Save(path);
+}
+
+void SetFontCacheDirectory(const char *directory) {
+  FontAtlasCache::SetDirectory(directory ? directory : "");
+}
+
+void SetAsyncIcons(bool enabled) { SvgRenderer::SetAsyncIcons(enabled); }
+void WaitForPendingIcons() { SvgRenderer::WaitForPendingIcons(); }
+
+void SetRenderBackend(RenderBackend *backend) { RenderBackend::Set(backend); }
+RenderBackend *GetRenderBackend() { return RenderBackend::Get(); }
+
+void SetPartialRedraw(bool enabled, Color background) {
+  DamageTracker::SetBackground(background);
+  DamageTracker::SetEnabled(enabled);
+}
+bool IsPartialRedraw() { return DamageTracker::IsEnabled(); }
+void InvalidateRegion(Rectangle bounds) { DamageTracker::Invalidate(bounds); }
+void SetDamageDebug(bool enabled) { DamageTracker::SetDebugOverlay(enabled); }
+bool IsDamageDebug() { return DamageTracker::IsDebugOverlay(); }
+DamageStats GetDamageStats() { return DamageTracker::GetStats(); }
+
+void SetPerfHud(bool enabled) { PerfCounters::SetHudEnabled(enabled); }
+bool IsPerfHud() { return PerfCounters::IsHudEnabled(); }
+PerfStats GetPerfStats() { return PerfCounters::GetLastFrame(); }
+
 static bool darkMode = false;
 
 void Initialize() {
@@ -124,6 +196,9 @@ void Shutdown() {
     return;
 
   SvgRenderer::Shutdown();
+  SdfRenderer::Shutdown();
+  ShadowCache::Shutdown();
+  RenderBackend::Get()->ReleaseRetained();
   Theme::Shutdown();
   initialized = false;
 }
@@ -135,8 +210,12 @@ void RequestCursor(int cursor) {
 void BeginFrame() {
   if (!initialized)
     Initialize();
+  PerfCounters::BeginFrame();
+  FontManager::BeginFrame();
+  SvgRenderer::BeginFrame();
   s_requestedCursor = MOUSE_CURSOR_DEFAULT;
   s_scissorDebugRects.clear();
+  DrawCommandBuffer::BeginFrame();
   TextFieldComponent::ResetFieldId();
   SliderComponent::ResetFieldId();
   RangeSliderComponent::ResetFieldId();
@@ -153,23 +232,36 @@ void DrawScissorDebug() {
   while (!s_scissorStack.empty()) {
     s_scissorStack.pop_back();
   }
-  EndScissorMode();
+  DrawCommandBuffer::ClearScissor();
   for (const Rectangle& r : s_scissorDebugRects) {
-    DrawRectangleRec(r, (Color){0, 255, 0, 35});
-    DrawRectangleLinesEx(r, 2.0f, (Color){0, 255, 0, 180});
+    Renderer::DrawRectangle(r, (Color){0, 255, 0, 35});
+    Renderer::DrawRectangleLines(r, 2.0f, (Color){0, 255, 0, 180});
   }
   s_scissorDebugRects.clear();
 }
 
 void EndFrame() {
-  SetMouseCursor(s_requestedCursor);
+  if (IsWindowReady())
+    SetMouseCursor(s_requestedCursor);
 
   TooltipManager::Update();
 
 #if RAYM3_USE_INPUT_LAYERS
   RenderQueue::ExecuteRenderQueue();
   InputLayerManager::EndFrame();
+  PerfCounters::Frame().blockingRegions =
+      InputLayerManager::GetBlockingRegionCount();
+  PerfCounters::Frame().renderQueue = RenderQueue::GetQueueSize();
 #endif
+
+  DrawCommandBuffer::EndFrame();
+  PerfCounters::EndFrame();
+  DamageTracker::DrawDebugOverlay();
+  PerfCounters::DrawHud();
+  ShadowCache::EndFrame();
+  GlyphAtlas::EndFrame();
+  FontManager::EndFrame();
+  SvgRenderer::EndFrame();
 }
 
 #if RAYM3_USE_INPUT_LAYERS
@@ -180,7 +272,7 @@ void PushLayer(int zOrder) {
   RenderQueue::PushLayer(zOrder);
 
   if (zOrder >= OVERLAY_LAYER_THRESHOLD) {
-    EndScissorMode();
+    DrawCommandBuffer::ClearScissor();
   }
 }
 
@@ -194,8 +286,7 @@ void PopLayer() {
   // If Layouts are nested in Layers, this might need refinement.
   
   if (InputLayerManager::GetCurrentLayerId() <= 0 && !s_scissorStack.empty()) {
-    Rectangle s = s_scissorStack.back();
-    BeginScissorMode((int)s.x, (int)s.y, (int)s.width, (int)s.height);
+    DrawCommandBuffer::SetScissor(s_scissorStack.back());
   }
 }
 #endif
@@ -208,6 +299,7 @@ void SetTheme(bool isDarkMode) {
 bool IsDarkMode() { return darkMode; }
 
 void SetIconBasePath(const char *path) { SvgRenderer::Initialize(path); }
+bool LoadIconPack(const char *path) { return SvgRenderer::LoadIconPack(path); }
 
 void BeginContainer(Rectangle bounds, LayoutDirection direction) {
   Container::Begin(bounds, direction);
@@ -273,6 +365,13 @@ void Text(const char *text, Rectangle bounds, float fontSize, Color color,
   TextComponent::Render(text, bounds, fontSize, color, weight, alignment);
 }
 
+void TextWrapped(const char *text, Rectangle bounds, float fontSize,
+                 Color color, FontWeight weight, TextAlignment alignment,
+                 int maxLines) {
+  TextComponent::RenderWrapped(text, bounds, fontSize, color, weight,
+                               alignment, maxLines);
+}
+
 void CircularProgressIndicator(Rectangle bounds, float value,
                                bool indeterminate, Color color,
                                float wiggleAmplitude, float wiggleFrequency) {
@@ -0,0 +1,322 @@
+#include "raym3/rendering/DamageTracker.h"
+#include "raym3/rendering/RenderBackend.h"
+#include "raym3/rendering/Renderer.h"
+#include "raym3/styles/Theme.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+namespace raym3 {
+
+// Above this many regions the pair whose union wastes the fewest pixels is
+// merged, so replay cost stays bounded on scattered damage.
+static constexpr int kMaxRegions = 8;
+
+bool DamageTracker::enabled_ = false;
+bool DamageTracker::debugOverlay_ = false;
+bool DamageTracker::invalidateAll_ = true;
+Color DamageTracker::background_ = {0, 0, 0, 0};
+Color DamageTracker::lastBackground_ = {0, 0, 0, 0};
+int DamageTracker::lastWidth_ = 0;
+int DamageTracker::lastHeight_ = 0;
+std::vector<DamageTracker::Signature> DamageTracker::previous_;
+std::vector<DamageTracker::Signature> DamageTracker::current_;
+std::vector<Rectangle> DamageTracker::invalidated_;
+std::vector<Rectangle> DamageTracker::overlays_;
+std::vector<Rectangle> DamageTracker::damage_;
+std::vector<Rectangle> DamageTracker::contentDamage_;
+DamageStats DamageTracker::stats_;
+
+// FNV-1a over the fields that affect a command's pixels. Padding and the
+// batch link are skipped so identical commands always hash the same.
+struct CommandHasher {
+  uint64_t hash = 1469598103934665603ull;
+
+  void Bytes(const void *data, size_t size) {
+    const unsigned char *p = (const unsigned char *)data;
+    for (size_t i = 0; i < size; i++) {
+      hash ^= p[i];
+      hash *= 1099511628211ull;
+    }
+  }
+  void Float(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Bytes(&bits, sizeof(bits));
+  }
+  void Rect(Rectangle r) {
+    Float(r.x);
+    Float(r.y);
+    Float(r.width);
+    Float(r.height);
+  }
+};
+
+static uint64_t HashCommand(const DrawCommand &cmd,
+                            const std::vector<TexturedQuad> &quads,
+                            const Rectangle *scissor) {
+  CommandHasher h;
+  uint8_t header[2] = {(uint8_t)cmd.type, cmd.segments};
+  h.Bytes(header, sizeof(header));
+  h.Bytes(&cmd.textureId, sizeof(cmd.textureId));
+  h.Bytes(&cmd.color, sizeof(cmd.color));
+  h.Rect(cmd.bounds);
+  if (scissor)
+    h.Rect(*scissor);
+
+  switch (cmd.type) {
+  case DrawCommandType::Rectangle:
+  case DrawCommandType::RectangleLines:
+  case DrawCommandType::RoundedRectangle:
+  case DrawCommandType::RoundedRectangleLines:
+    h.Rect(cmd.rect.rec);
+    h.Float(cmd.rect.roundness);
+    h.Float(cmd.rect.lineWidth);
+    break;
+  case DrawCommandType::Ring:
+    h.Float(cmd.ring.center.x);
+    h.Float(cmd.ring.center.y);
+    h.Float(cmd.ring.innerRadius);
+    h.Float(cmd.ring.outerRadius);
+    h.Float(cmd.ring.startAngle);
+    h.Float(cmd.ring.endAngle);
+    break;
+  case DrawCommandType::Line:
+    h.Float(cmd.line.start.x);
+    h.Float(cmd.line.start.y);
+    h.Float(cmd.line.end.x);
+    h.Float(cmd.line.end.y);
+    h.Float(cmd.line.thickness);
+    break;
+  case DrawCommandType::Triangle:
+    h.Float(cmd.triangle.v1.x);
+    h.Float(cmd.triangle.v1.y);
+    h.Float(cmd.triangle.v2.x);
+    h.Float(cmd.triangle.v2.y);
+    h.Float(cmd.triangle.v3.x);
+    h.Float(cmd.triangle.v3.y);
+    break;
+  case DrawCommandType::Quads:
+  case DrawCommandType::SdfQuads:
+    h.Float(cmd.quads.textureWidth);
+    h.Float(cmd.quads.textureHeight);
+    for (uint32_t i = 0; i < cmd.quads.quadCount; i++) {
+      const TexturedQuad &quad = quads[cmd.quads.firstQuad + i];
+      h.Rect(quad.source);
+      h.Rect(quad.dest);
+    }
+    break;
+  case DrawCommandType::SdfRectangle:
+    h.Rect(cmd.sdf.rec);
+    h.Float(cmd.sdf.radius);
+    h.Float(cmd.sdf.lineWidth);
+    h.Float(cmd.sdf.softness);
+    break;
+  }
+  return h.hash;
+}
+
+static Rectangle Intersect(Rectangle a, Rectangle b) {
+  float left = std::max(a.x, b.x);
+  float top = std::max(a.y, b.y);
+  float right = std::min(a.x + a.width, b.x + b.width);
+  float bottom = std::min(a.y + a.height, b.y + b.height);
+  if (right <= left || bottom <= top)
+    return {0, 0, 0, 0};
+  return {left, top, right - left, bottom - top};
+}
+
+static Rectangle Union(Rectangle a, Rectangle b) {
+  float left = std::min(a.x, b.x);
+  float top = std::min(a.y, b.y);
+  float right = std::max(a.x + a.width, b.x + b.width);
+  float bottom = std::max(a.y + a.height, b.y + b.height);
+  return {left, top, right - left, bottom - top};
+}
+
+static bool Touches(Rectangle a, Rectangle b) {
+  return a.x <= b.x + b.width && b.x <= a.x + a.width &&
+         a.y <= b.y + b.height && b.y <= a.y + a.height;
+}
+
+static float Area(Rectangle r) { return r.width * r.height; }
+
+void DamageTracker::SetEnabled(bool enabled) {
+  if (enabled && !enabled_)
+    Discard();
+  enabled_ = enabled;
+  DrawCommandBuffer::SyncEnabled();
+  if (!enabled)
+    RenderBackend::Get()->ReleaseRetained();
+}
+
+Color DamageTracker::GetBackground() {
+  if (background_.a != 0)
+    return background_;
+  return Theme::GetColorScheme().surface;
+}
+
+void DamageTracker::Invalidate(Rectangle bounds) {
+  if (enabled_ && bounds.width > 0.0f && bounds.height > 0.0f)
+    invalidated_.push_back(bounds);
+}
+
+void DamageTracker::InvalidateOverlay(Rectangle bounds) {
+  if (enabled_ && bounds.width > 0.0f && bounds.height > 0.0f)
+    overlays_.push_back(bounds);
+}
+
+void DamageTracker::Discard() {
+  previous_.clear();
+  invalidated_.clear();
+  overlays_.clear();
+  invalidateAll_ = true;
+}
+
+// Inserts a region, absorbing every region it touches so the list stays
+// disjoint, then merges the cheapest pair while over the limit.
+void DamageTracker::AddRegion(Rectangle region) {
+  for (size_t i = 0; i < damage_.size();) {
+    if (Touches(damage_[i], region)) {
+      region = Union(region, damage_[i]);
+      damage_.erase(damage_.begin() + i);
+      i = 0;
+    } else {
+      i++;
+    }
+  }
+  damage_.push_back(region);
+
+  if ((int)damage_.size() <= kMaxRegions)
+    return;
+  size_t bestA = 0, bestB = 1;
+  float bestWaste = -1.0f;
+  for (size_t a = 0; a < damage_.size(); a++) {
+    for (size_t b = a + 1; b < damage_.size(); b++) {
+      float waste = Area(Union(damage_[a], damage_[b])) - Area(damage_[a]) -
+                    Area(damage_[b]);
+      if (bestWaste < 0.0f || waste < bestWaste) {
+        bestWaste = waste;
+        bestA = a;
+        bestB = b;
+      }
+    }
+  }
+  Rectangle merged = Union(damage_[bestA], damage_[bestB]);
+  damage_.erase(damage_.begin() + bestB);
+  damage_.erase(damage_.begin() + bestA);
+  AddRegion(merged);
+}
+
+void DamageTracker::AddChanged(Rectangle changed, Rectangle screen) {
+  if (changed.width <= 0.0f || changed.height <= 0.0f)
+    return;
+  float left = std::floor(changed.x - 1.0f);
+  float top = std::floor(changed.y - 1.0f);
+  float right = std::ceil(changed.x + changed.width + 1.0f);
+  float bottom = std::ceil(changed.y + changed.height + 1.0f);
+  Rectangle clipped =
+      Intersect({left, top, right - left, bottom - top}, screen);
+  if (clipped.width > 0.0f)
+    AddRegion(clipped);
+}
+
+const std::vector<Rectangle> &
+DamageTracker::ComputeDamage(const std::vector<DrawCommand> &commands,
+                             const std::vector<TexturedQuad> &quads,
+                             const std::vector<Rectangle> &scissors,
+                             bool surfaceIntact) {
+  RenderBackend *backend = RenderBackend::Get();
+  int width = backend->GetScreenWidth();
+  int height = backend->GetScreenHeight();
+  Rectangle screen = {0, 0, (float)width, (float)height};
+  Color background = GetBackground();
+
+  current_.clear();
+  for (const DrawCommand &cmd : commands) {
+    const Rectangle *scissor =
+        cmd.scissor != 0 ? &scissors[cmd.scissor] : nullptr;
+    Rectangle bounds = scissor ? Intersect(cmd.bounds, *scissor) : cmd.bounds;
+    current_.push_back({HashCommand(cmd, quads, scissor), bounds});
+  }
+
+  bool full = invalidateAll_ || !surfaceIntact || width != lastWidth_ ||
+              height != lastHeight_ ||
+              std::memcmp(&background, &lastBackground_, sizeof(Color)) != 0;
+
+  damage_.clear();
+  if (full) {
+    damage_.push_back(screen);
+  } else {
+    // Multiset diff: commands without an identical counterpart in the other
+    // frame damage their bounds; unchanged commands cost nothing.
+    std::unordered_map<uint64_t, int> unmatched;
+    for (const Signature &sig : previous_)
+      unmatched[sig.hash]++;
+    std::vector<Rectangle> changed = invalidated_;
+    for (const Signature &sig : current_) {
+      auto it = unmatched.find(sig.hash);
+      if (it != unmatched.end() && it->second > 0)
+        it->second--;
+      else
+        changed.push_back(sig.bounds);
+    }
+    for (const Signature &sig : previous_) {
+      int &count = unmatched[sig.hash];
+      if (count > 0) {
+        count--;
+        changed.push_back(sig.bounds);
+      }
+    }
+
+    for (Rectangle r : changed)
+      AddChanged(r, screen);
+  }
+
+  // Stats cover the content only; what the overlays cover is added after.
+  float pixels = 0.0f;
+  for (const Rectangle &r : damage_)
+    pixels += Area(r);
+  stats_.regions = (int)damage_.size();
+  stats_.fullRedraw = full;
+  float area = (float)width * (float)height;
+  stats_.repaintedPercent = area > 0.0f ? 100.0f * pixels / area : 0.0f;
+  contentDamage_ = damage_;
+  if (!full && backend->RetainsOverlays()) {
+    for (Rectangle r : overlays_)
+      AddChanged(r, screen);
+  }
+
+  previous_.swap(current_);
+  invalidated_.clear();
+  overlays_.clear();
+  invalidateAll_ = false;
+  lastWidth_ = width;
+  lastHeight_ = height;
+  lastBackground_ = background;
+  return damage_;
+}
+
+void DamageTracker::DrawDebugOverlay() {
+  if (!enabled_ || !debugOverlay_)
+    return;
+  // Regions repainted only to clear last frame's overlay are not outlined,
+  // or each outline would repaint and outline itself forever.
+  for (const Rectangle &r : contentDamage_) {
+    Renderer::DrawRectangle(r, (Color){255, 0, 255, 40});
+    Renderer::DrawRectangleLines(r, 2.0f, (Color){255, 0, 255, 200});
+    InvalidateOverlay(r);
+  }
+
+  char label[48];
+  snprintf(label, sizeof(label), "Repainted %.1f%%", stats_.repaintedPercent);
+  Vector2 size = Renderer::MeasureText(label, 14.0f);
+  Rectangle box = {8, 8, size.x + 12.0f, size.y + 8.0f};
+  Renderer::DrawRectangle(box, (Color){0, 0, 0, 170});
+  Renderer::DrawText(label, {box.x + 6.0f, box.y + 4.0f}, 14.0f, WHITE);
+  InvalidateOverlay(box);
+}
+
+} // namespace raym3
@@ -0,0 +1,309 @@
+#include "raym3/rendering/DrawCommandBuffer.h"
+#include "raym3/rendering/DamageTracker.h"
+#include "raym3/rendering/RenderBackend.h"
+#include <algorithm>
+
+namespace raym3 {
+
+// How many batches back a command may travel to join a batch with the same
+// texture/scissor. Bounds the flush cost on very dense frames.
+static constexpr int kMergeWindow = 32;
+// Batches larger than this are tested against their union bounds only.
+static constexpr int kDetailedOverlapLimit = 16;
+
+bool DrawCommandBuffer::requested_ = false;
+bool DrawCommandBuffer::enabled_ = false;
+bool DrawCommandBuffer::recording_ = false;
+bool DrawCommandBuffer::flushedMidFrame_ = false;
+std::vector<DrawCommand> DrawCommandBuffer::commands_;
+std::vector<TexturedQuad> DrawCommandBuffer::quads_;
+std::vector<DrawCommandBuffer::Batch> DrawCommandBuffer::batches_;
+std::vector<Rectangle> DrawCommandBuffer::scissors_ = {{0, 0, 0, 0}};
+uint16_t DrawCommandBuffer::currentScissor_ = 0;
+bool DrawCommandBuffer::scissorApplied_ = false;
+Rectangle DrawCommandBuffer::appliedScissor_ = {0, 0, 0, 0};
+DrawBatchStats DrawCommandBuffer::frameStats_;
+DrawBatchStats DrawCommandBuffer::lastFrameStats_;
+
+static bool RectsOverlap(Rectangle a, Rectangle b) {
+  // Pad by a pixel so edge-sharing primitives with filtered or multisampled
+  // edges keep their relative order.
+  return a.x - 1.0f < b.x + b.width && b.x - 1.0f < a.x + a.width &&
+         a.y - 1.0f < b.y + b.height && b.y - 1.0f < a.y + a.height;
+}
+
+static Rectangle UnionRects(Rectangle a, Rectangle b) {
+  float left = std::min(a.x, b.x);
+  float top = std::min(a.y, b.y);
+  float right = std::max(a.x + a.width, b.x + b.width);
+  float bottom = std::max(a.y + a.height, b.y + b.height);
+  return {left, top, right - left, bottom - top};
+}
+
+static Rectangle IntersectRects(Rectangle a, Rectangle b) {
+  float left = std::max(a.x, b.x);
+  float top = std::max(a.y, b.y);
+  float right = std::min(a.x + a.width, b.x + b.width);
+  float bottom = std::min(a.y + a.height, b.y + b.height);
+  if (right <= left || bottom <= top)
+    return {0, 0, 0, 0};
+  return {left, top, right - left, bottom - top};
+}
+
+// Approximate vertex count of a command as raylib tessellates it.
+static int VertexCount(const DrawCommand &cmd) {
+  int segments = std::max((int)cmd.segments, 1);
+  switch (cmd.type) {
+  case DrawCommandType::Rectangle:
+  case DrawCommandType::Line:
+    return 4;
+  case DrawCommandType::RectangleLines:
+    return 16;
+  case DrawCommandType::RoundedRectangle:
+    return 4 * segments * 3 + 5 * 4; // Corner fans plus five quads
+  case DrawCommandType::RoundedRectangleLines:
+    return 4 * segments * 4 + 4 * 4; // Corner arcs plus four edges
+  case DrawCommandType::Ring:
+    return segments * 4;
+  case DrawCommandType::Triangle:
+    return 3;
+  case DrawCommandType::Quads:
+  case DrawCommandType::SdfQuads:
+    return (int)cmd.quads.quadCount * 4;
+  case DrawCommandType::SdfRectangle:
+    return 6;
+  }
+  return 0;
+}
+
+static uint64_t BatchKey(const DrawCommand &cmd) {
+  return ((uint64_t)cmd.scissor << 32) | (uint64_t)cmd.textureId;
+}
+
+void DrawCommandBuffer::SetEnabled(bool enabled) {
+  requested_ = enabled;
+  SyncEnabled();
+}
+
+void DrawCommandBuffer::SyncEnabled() {
+  // Partial redraw replays recorded commands, so it keeps recording on.
+  bool enabled = requested_ || DamageTracker::IsEnabled();
+  if (enabled_ && !enabled) {
+    Flush();
+    recording_ = false;
+  }
+  enabled_ = enabled;
+}
+
+void DrawCommandBuffer::BeginFrame() {
+  Reset();
+  currentScissor_ = 0;
+  frameStats_ = {};
+  recording_ = enabled_;
+  flushedMidFrame_ = false;
+}
+
+void DrawCommandBuffer::EndFrame() {
+  if (recording_) {
+    if (!DamageTracker::IsEnabled()) {
+      EmitAll();
+    } else if (flushedMidFrame_) {
+      // Part of the frame already went straight to the screen; the retained
+      // surface cannot be trusted for the next frame either.
+      DamageTracker::Discard();
+      EmitAll();
+    } else {
+      EmitDamaged();
+    }
+  }
+  recording_ = false;
+  lastFrameStats_ = frameStats_;
+}
+
+void DrawCommandBuffer::Submit(DrawCommand cmd) {
+  frameStats_.commands++;
+  if (!recording_) {
+    frameStats_.batches++;
+    frameStats_.vertices += VertexCount(cmd);
+    RenderBackend *backend = RenderBackend::Get();
+    backend->BeginBatch();
+    backend->Execute(cmd, quads_.data());
+    backend->EndBatch();
+    quads_.clear();
+    return;
+  }
+  cmd.scissor = currentScissor_;
+  cmd.next = -1;
+  commands_.push_back(cmd);
+}
+
+void DrawCommandBuffer::SetScissor(Rectangle bounds) {
+  if (!recording_) {
+    RenderBackend::Get()->SetScissor(&bounds);
+    return;
+  }
+  Rectangle current = scissors_[currentScissor_];
+  if (currentScissor_ != 0 && current.x == bounds.x && current.y == bounds.y &&
+      current.width == bounds.width && current.height == bounds.height)
+    return;
+  if (scissors_.size() >= UINT16_MAX)
+    Flush();
+  scissors_.push_back(bounds);
+  currentScissor_ = (uint16_t)(scissors_.size() - 1);
+}
+
+void DrawCommandBuffer::ClearScissor() {
+  if (!recording_) {
+    RenderBackend::Get()->SetScissor(nullptr);
+    return;
+  }
+  currentScissor_ = 0;
+}
+
+void DrawCommandBuffer::Flush() {
+  if (!recording_)
+    return;
+  flushedMidFrame_ = true;
+  EmitAll();
+}
+
+void DrawCommandBuffer::EmitAll() {
+  scissorApplied_ = false;
+  if (!commands_.empty()) {
+    frameStats_.flushes++;
+    BuildBatches();
+    EmitBatches();
+  }
+
+  // Leave the GPU in the recorded scissor state so immediate raylib drawing
+  // that follows the flush is clipped like the surrounding commands.
+  ApplyScissor(currentScissor_ != 0 ? &scissors_[currentScissor_] : nullptr);
+  Reset();
+}
+
+void DrawCommandBuffer::EmitDamaged() {
+  RenderBackend *backend = RenderBackend::Get();
+  bool intact = backend->BeginRetained();
+  const std::vector<Rectangle> &damage =
+      DamageTracker::ComputeDamage(commands_, quads_, scissors_, intact);
+
+  scissorApplied_ = false;
+  if (!damage.empty()) {
+    frameStats_.flushes++;
+    BuildBatches();
+    Color background = DamageTracker::GetBackground();
+    for (const Rectangle &region : damage) {
+      backend->ClearRegion(region, background);
+      scissorApplied_ = false;
+      EmitBatches(&region);
+    }
+  }
+
+  ApplyScissor(nullptr);
+  backend->EndRetained();
+  Reset();
+}
+
+void DrawCommandBuffer::Reset() {
+  commands_.clear();
+  quads_.clear();
+  batches_.clear();
+  Rectangle current = scissors_[currentScissor_];
+  scissors_.resize(1);
+  if (currentScissor_ != 0) {
+    scissors_.push_back(current);
+    currentScissor_ = 1;
+  }
+}
+
+bool DrawCommandBuffer::BatchOverlaps(const Batch &batch, Rectangle bounds) {
+  if (!RectsOverlap(batch.bounds, bounds))
+    return false;
+  if (batch.count > kDetailedOverlapLimit)
+    return true;
+  for (int i = batch.first; i != -1; i = commands_[i].next) {
+    if (RectsOverlap(commands_[i].bounds, bounds))
+      return true;
+  }
+  return false;
+}
+
+void DrawCommandBuffer::BuildBatches() {
+  batches_.clear();
+  for (int i = 0; i < (int)commands_.size(); i++) {
+    DrawCommand &cmd = commands_[i];
+    uint64_t key = BatchKey(cmd);
+
+    // Walk back through recent batches. The command may join a batch with the
+    // same key only if it does not overlap anything painted after that batch.
+    int target = -1;
+    int stop = std::max(0, (int)batches_.size() - kMergeWindow);
+    for (int b = (int)batches_.size() - 1; b >= stop; b--) {
+      if (batches_[b].key == key) {
+        target = b;
+        break;
+      }
+      if (BatchOverlaps(batches_[b], cmd.bounds))
+        break;
+    }
+
+    if (target == -1) {
+      batches_.push_back({key, cmd.bounds, i, i, 1});
+      continue;
+    }
+
+    Batch &batch = batches_[target];
+    commands_[batch.last].next = i;
+    batch.last = i;
+    batch.count++;
+    batch.bounds = UnionRects(batch.bounds, cmd.bounds);
+  }
+}
+
+void DrawCommandBuffer::EmitBatches(const Rectangle *clip) {
+  RenderBackend *backend = RenderBackend::Get();
+  for (const Batch &batch : batches_) {
+    uint16_t scissor = commands_[batch.first].scissor;
+    const Rectangle *bounds = scissor != 0 ? &scissors_[scissor] : nullptr;
+    Rectangle clipped;
+    if (clip) {
+      if (!RectsOverlap(batch.bounds, *clip))
+        continue;
+      clipped = bounds ? IntersectRects(*bounds, *clip) : *clip;
+      if (clipped.width <= 0.0f)
+        continue;
+      bounds = &clipped;
+    }
+
+    ApplyScissor(bounds);
+    backend->BeginBatch();
+    for (int i = batch.first; i != -1; i = commands_[i].next) {
+      if (clip && !RectsOverlap(commands_[i].bounds, *clip))
+        continue;
+      frameStats_.vertices += VertexCount(commands_[i]);
+      backend->Execute(commands_[i], quads_.data());
+    }
+    backend->EndBatch();
+    frameStats_.batches++;
+  }
+}
+
+void DrawCommandBuffer::ApplyScissor(const Rectangle *bounds) {
+  if (!bounds) {
+    if (scissorApplied_ && appliedScissor_.width == 0)
+      return;
+    RenderBackend::Get()->SetScissor(nullptr);
+    appliedScissor_ = {0, 0, 0, 0};
+    scissorApplied_ = true;
+    return;
+  }
+  Rectangle r = *bounds;
+  if (scissorApplied_ && appliedScissor_.x == r.x && appliedScissor_.y == r.y &&
+      appliedScissor_.width == r.width && appliedScissor_.height == r.height)
+    return;
+  RenderBackend::Get()->SetScissor(&r);
+  appliedScissor_ = r;
+  scissorApplied_ = true;
+}
+
+} // namespace raym3
@@ -0,0 +1,266 @@
+#include "raym3/rendering/IconAtlas.h"
+#include "raym3/rendering/RenderBackend.h"
+#include <algorithm>
+#include <cstring>
+
+namespace raym3 {
+
+// 512 KB of gray-alpha; about 350 padded 24px icons.
+static constexpr int kPageSize = 512;
+// Transparent border so bilinear sampling never reaches a neighbour.
+static constexpr int kPadding = 1;
+// Shelf heights are rounded up to this, so near sizes share a shelf.
+static constexpr int kShelfStep = 4;
+
+std::vector<IconAtlas::Page> IconAtlas::pages_;
+std::vector<IconSlot> IconAtlas::freed_;
+IconAtlasStats IconAtlas::stats_;
+int IconAtlas::batchDepth_ = 0;
+
+// White with zero alpha, like the icons' own transparent texels, so filtered
+// edges do not darken.
+static void FillTransparent(unsigned char *grayAlpha, size_t pixels) {
+  for (size_t i = 0; i < pixels; i++) {
+    grayAlpha[i * 2 + 0] = 255;
+    grayAlpha[i * 2 + 1] = 0;
+  }
+}
+
+static Texture2D LoadPageTexture(unsigned char *grayAlpha, int width,
+                                 int height) {
+  Image image = {.data = grayAlpha,
+                 .width = width,
+                 .height = height,
+                 .mipmaps = 1,
+                 .format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA};
+  RenderBackend *backend = RenderBackend::Get();
+  Texture2D texture = backend->LoadTexture(image);
+  if (texture.id != 0)
+    backend->SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
+  return texture;
+}
+
+int IconAtlas::CreatePage(int width, int height) {
+  std::vector<unsigned char> pixels((size_t)width * height * 2);
+  FillTransparent(pixels.data(), (size_t)width * height);
+  // In a batch the texture is created at EndBatch(), with the icons in it.
+  Texture2D texture = {0};
+  if (batchDepth_ == 0) {
+    texture = LoadPageTexture(pixels.data(), width, height);
+    if (texture.id == 0)
+      return -1;
+  }
+
+  // Reuse the index of an unloaded page so slot page numbers stay small.
+  size_t index = 0;
+  while (index < pages_.size() && pages_[index].InUse())
+    index++;
+  if (index == pages_.size())
+    pages_.emplace_back();
+  pages_[index] = {texture, width, height, 0, 0, {}, {}};
+  if (batchDepth_ > 0)
+    pages_[index].staging = std::move(pixels);
+  stats_.pages++;
+  stats_.bytes += (size_t)width * height * 2;
+  return (int)index;
+}
+
+bool IconAtlas::Pack(Page &page, int width, int height, int *x, int *y) {
+  // The lowest shelf the icon fits without wasting over half its height;
+  // empty shelves take any icon.
+  Shelf *best = nullptr;
+  size_t bestSpan = 0;
+  for (Shelf &shelf : page.shelves) {
+    if (shelf.height < height ||
+        (shelf.icons > 0 && shelf.height > height + height / 2))
+      continue;
+    if (best && shelf.height >= best->height)
+      continue;
+    for (size_t i = 0; i < shelf.free.size(); i++) {
+      if (shelf.free[i].width >= width) {
+        best = &shelf;
+        bestSpan = i;
+        break;
+      }
+    }
+  }
+
+  if (!best) {
+    int shelfHeight = (height + kShelfStep - 1) / kShelfStep * kShelfStep;
+    shelfHeight = std::min(shelfHeight, page.height - page.top);
+    if (shelfHeight < height || width > page.width)
+      return false;
+    page.shelves.push_back({page.top, shelfHeight, 0, {{0, page.width}}});
+    page.top += shelfHeight;
+    best = &page.shelves.back();
+    bestSpan = 0;
+  }
+
+  Span &span = best->free[bestSpan];
+  *x = span.x;
+  *y = best->y;
+  span.x += width;
+  span.width -= width;
+  if (span.width == 0)
+    best->free.erase(best->free.begin() + bestSpan);
+  best->icons++;
+  page.icons++;
+  return true;
+}
+
+void IconAtlas::Release(Page &page, int x, int y, int width) {
+  auto shelf = std::find_if(page.shelves.begin(), page.shelves.end(),
+                            [y](const Shelf &s) { return s.y == y; });
+  if (shelf == page.shelves.end())
+    return;
+
+  auto next = std::lower_bound(
+      shelf->free.begin(), shelf->free.end(), x,
+      [](const Span &span, int value) { return span.x < value; });
+  next = shelf->free.insert(next, {x, width});
+  // Merge with the following span, then the preceding one.
+  if (next + 1 != shelf->free.end() && next->x + next->width == (next + 1)->x) {
+    next->width += (next + 1)->width;
+    shelf->free.erase(next + 1);
+  }
+  if (next != shelf->free.begin() &&
+      (next - 1)->x + (next - 1)->width == next->x) {
+    (next - 1)->width += next->width;
+    shelf->free.erase(next);
+  }
+  shelf->icons--;
+  page.icons--;
+
+  // Empty shelves at the bottom give their rows back to the page.
+  while (!page.shelves.empty() && page.shelves.back().icons == 0) {
+    page.top = page.shelves.back().y;
+    page.shelves.pop_back();
+  }
+}
+
+bool IconAtlas::Add(const unsigned char *grayAlpha, int width, int height,
+                    IconSlot *slot) {
+  int paddedW = width + 2 * kPadding;
+  int paddedH = height + 2 * kPadding;
+
+  int page = -1;
+  int x = 0, y = 0;
+  for (size_t i = 0; i < pages_.size() && page < 0; i++) {
+    if (pages_[i].InUse() && Pack(pages_[i], paddedW, paddedH, &x, &y))
+      page = (int)i;
+  }
+  if (page < 0) {
+    bool oversized = paddedW > kPageSize || paddedH > kPageSize;
+    page = oversized ? CreatePage(paddedW, paddedH)
+                     : CreatePage(kPageSize, kPageSize);
+    if (page < 0 || !Pack(pages_[page], paddedW, paddedH, &x, &y))
+      return false;
+  }
+
+  Page &target = pages_[page];
+  if (!target.staging.empty()) {
+    // A new page's border texels are still transparent.
+    for (int row = 0; row < height; row++) {
+      size_t offset = ((size_t)(y + kPadding + row) * target.width + x +
+                       kPadding) * 2;
+      memcpy(&target.staging[offset], grayAlpha + (size_t)row * width * 2,
+             (size_t)width * 2);
+    }
+  } else {
+    // The slot may hold an older icon's pixels, so the border is written
+    // too.
+    std::vector<unsigned char> padded((size_t)paddedW * paddedH * 2);
+    FillTransparent(padded.data(), (size_t)paddedW * paddedH);
+    for (int row = 0; row < height; row++) {
+      memcpy(&padded[((size_t)(row + kPadding) * paddedW + kPadding) * 2],
+             grayAlpha + (size_t)row * width * 2, (size_t)width * 2);
+    }
+    RenderBackend::Get()->UpdateTexture(
+        target.texture, {(float)x, (float)y, (float)paddedW, (float)paddedH},
+        padded.data());
+    stats_.uploads++;
+  }
+
+  slot->page = page;
+  slot->rect = {(float)(x + kPadding), (float)(y + kPadding), (float)width,
+                (float)height};
+  stats_.icons++;
+  UpdateUsage();
+  return true;
+}
+
+void IconAtlas::EndBatch() {
+  if (batchDepth_ == 0 || --batchDepth_ > 0)
+    return;
+  for (Page &page : pages_) {
+    if (page.staging.empty())
+      continue;
+    page.texture = LoadPageTexture(page.staging.data(), page.width,
+                                   page.height);
+    if (page.texture.id == 0)
+      continue;
+    page.staging = {};
+    stats_.uploads++;
+  }
+}
+
+void IconAtlas::Free(const IconSlot &slot) {
+  if (slot.page >= 0)
+    freed_.push_back(slot);
+}
+
+Texture2D IconAtlas::GetTexture(int page) {
+  if (page < 0 || page >= (int)pages_.size())
+    return {0};
+  return pages_[page].texture;
+}
+
+void IconAtlas::EndFrame() {
+  if (freed_.empty())
+    return;
+  for (const IconSlot &slot : freed_) {
+    Page &page = pages_[slot.page];
+    Release(page, (int)slot.rect.x - kPadding, (int)slot.rect.y - kPadding,
+            (int)slot.rect.width + 2 * kPadding);
+    stats_.icons--;
+    if (page.icons == 0 && page.InUse()) {
+      if (page.texture.id != 0)
+        RenderBackend::Get()->UnloadTexture(page.texture);
+      stats_.bytes -= (size_t)page.width * page.height * 2;
+      page = {};
+      stats_.pages--;
+    }
+  }
+  freed_.clear();
+  UpdateUsage();
+}
+
+void IconAtlas::UpdateUsage() {
+  long long used = 0;
+  long long total = 0;
+  for (const Page &page : pages_) {
+    if (!page.InUse())
+      continue;
+    total += (long long)page.width * page.height;
+    for (const Shelf &shelf : page.shelves) {
+      int freeWidth = 0;
+      for (const Span &span : shelf.free)
+        freeWidth += span.width;
+      used += (long long)(page.width - freeWidth) * shelf.height;
+    }
+  }
+  stats_.usage = total > 0 ? (float)used / (float)total : 0.0f;
+}
+
+void IconAtlas::Shutdown() {
+  for (Page &page : pages_) {
+    if (page.texture.id != 0)
+      RenderBackend::Get()->UnloadTexture(page.texture);
+  }
+  pages_.clear();
+  freed_.clear();
+  stats_ = {};
+  batchDepth_ = 0;
+}
+
+} // namespace raym3
@@ -0,0 +1,548 @@
+#include "raym3/rendering/IconPack.h"
+#include "raym3/rendering/SvgModel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include "external/nanosvg.h"
+
+namespace raym3 {
+
+// Bump when the layout below or the shape encoding changes.
+static constexpr uint32_t kFormatVersion = 1;
+static constexpr char kMagic[4] = {'R', 'M', '3', 'I'};
+static constexpr int kVariations = 5;
+// Points are quantized to the finest power-of-two step that keeps them
+// within this many steps of the origin. A power of two represents integer
+// and half coordinates exactly, so edges on pixel boundaries stay there.
+static constexpr float kMaxSteps = 32768.0f;
+
+struct PackHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t entryCount;
+  uint32_t variationFirst[kVariations]; // First entry of each variation
+};
+
+struct PackRecord {
+  uint32_t nameOffset; // From the start of the file
+  uint32_t dataOffset;
+  uint32_t dataSize;
+  uint16_t nameLength;
+  uint8_t svg; // Data is SVG text rather than encoded shapes
+  uint8_t reserved;
+};
+
+static_assert(sizeof(PackHeader) == 32, "PackHeader must not be padded");
+static_assert(sizeof(PackRecord) == 16, "PackRecord must not be padded");
+
+std::unique_ptr<MappedFile> IconPack::file_;
+std::string IconPack::path_;
+IconPackStats IconPack::stats_;
+
+namespace {
+
+class Writer {
+public:
+  explicit Writer(std::vector<unsigned char> *out) : out_(out) {}
+
+  void U8(uint8_t v) { out_->push_back(v); }
+  void U32(uint32_t v) { Raw(&v, sizeof(v)); }
+  void F32(float v) { Raw(&v, sizeof(v)); }
+  void Varint(uint32_t v) {
+    while (v >= 0x80) {
+      out_->push_back((uint8_t)(v | 0x80));
+      v >>= 7;
+    }
+    out_->push_back((uint8_t)v);
+  }
+  // Zigzag, so small negative deltas stay one byte.
+  void Svarint(int32_t v) {
+    Varint(((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+  }
+
+private:
+  void Raw(const void *data, size_t size) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    out_->insert(out_->end(), bytes, bytes + size);
+  }
+
+  std::vector<unsigned char> *out_;
+};
+
+// Bounds-checked; after a read past the end every value is 0 and ok() is
+// false.
+class Reader {
+public:
+  Reader(const unsigned char *data, size_t size)
+      : p_(data), end_(data + size) {}
+
+  bool ok() const { return ok_; }
+
+  uint8_t U8() {
+    if (!Need(1))
+      return 0;
+    return *p_++;
+  }
+  uint32_t U32() {
+    uint32_t v = 0;
+    Raw(&v, sizeof(v));
+    return v;
+  }
+  float F32() {
+    float v = 0.0f;
+    Raw(&v, sizeof(v));
+    return v;
+  }
+  uint32_t Varint() {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      uint8_t byte = U8();
+      v |= (uint32_t)(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return v;
+    }
+    ok_ = false;
+    return 0;
+  }
+  int32_t Svarint() {
+    uint32_t v = Varint();
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+  }
+
+private:
+  bool Need(size_t size) {
+    if (!ok_ || (size_t)(end_ - p_) < size) {
+      ok_ = false;
+      return false;
+    }
+    return true;
+  }
+  void Raw(void *out, size_t size) {
+    if (!Need(size))
+      return;
+    memcpy(out, p_, size);
+    p_ += size;
+  }
+
+  const unsigned char *p_;
+  const unsigned char *end_;
+  bool ok_ = true;
+};
+
+} // namespace
+
+static const PackHeader &Header(const MappedFile &file) {
+  return *(const PackHeader *)file.data();
+}
+
+static const PackRecord *Records(const MappedFile &file) {
+  return (const PackRecord *)(file.data() + sizeof(PackHeader));
+}
+
+bool IconPack::Open(const std::string &path) {
+  Close();
+  auto file = std::make_unique<MappedFile>(path);
+  if (!file->data() || file->size() < sizeof(PackHeader))
+    return false;
+  const PackHeader &header = Header(*file);
+  if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kFormatVersion ||
+      (file->size() - sizeof(PackHeader)) / sizeof(PackRecord) <
+          header.entryCount)
+    return false;
+  for (int v = 0; v < kVariations; v++) {
+    uint32_t end = v + 1 < kVariations ? header.variationFirst[v + 1]
+                                       : header.entryCount;
+    if (header.variationFirst[v] > end || end > header.entryCount)
+      return false;
+  }
+  // Checking every record once here keeps lookups free of bounds checks.
+  const PackRecord *records = Records(*file);
+  for (uint32_t i = 0; i < header.entryCount; i++) {
+    const PackRecord &record = records[i];
+    if ((uint64_t)record.nameOffset + record.nameLength > file->size() ||
+        (uint64_t)record.dataOffset + record.dataSize > file->size())
+      return false;
+  }
+
+  stats_.entries = (int)header.entryCount;
+  stats_.bytes = file->size();
+  file_ = std::move(file);
+  path_ = path;
+  return true;
+}
+
+void IconPack::Close() {
+  file_.reset();
+  path_.clear();
+  stats_ = {};
+}
+
+const unsigned char *IconPack::Find(int variation, const char *name,
+                                    size_t *size, bool *svg) {
+  if (!file_ || variation < 0 || variation >= kVariations)
+    return nullptr;
+  const PackHeader &header = Header(*file_);
+  const PackRecord *records = Records(*file_);
+  const unsigned char *base = file_->data();
+  size_t length = strlen(name);
+
+  uint32_t lo = header.variationFirst[variation];
+  uint32_t hi = variation + 1 < kVariations
+                    ? header.variationFirst[variation + 1]
+                    : header.entryCount;
+  while (lo < hi) {
+    uint32_t mid = lo + (hi - lo) / 2;
+    const PackRecord &record = records[mid];
+    int cmp = memcmp(base + record.nameOffset, name,
+                     std::min<size_t>(record.nameLength, length));
+    if (cmp == 0)
+      cmp = (record.nameLength > length) - (record.nameLength < length);
+    if (cmp == 0) {
+      *size = record.dataSize;
+      *svg = record.svg != 0;
+      return base + record.dataOffset;
+    }
+    if (cmp < 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return nullptr;
+}
+
+bool IconPack::Contains(int variation, const char *name) {
+  size_t size;
+  bool svg;
+  return Find(variation, name, &size, &svg) != nullptr;
+}
+
+static void DeleteShapes(NSVGshape *shape) {
+  while (shape) {
+    NSVGshape *next = shape->next;
+    for (NSVGpath *path = shape->paths; path != nullptr;) {
+      NSVGpath *nextPath = path->next;
+      free(path->pts);
+      free(path);
+      path = nextPath;
+    }
+    free(shape);
+    shape = next;
+  }
+}
+
+static NSVGimage *Discard(NSVGimage *image) {
+  DeleteShapes(image->shapes);
+  free(image);
+  return nullptr;
+}
+
+static bool InRange(int value, int first, int last) {
+  return value >= first && value <= last;
+}
+
+// Allocated with malloc, as nsvgDelete() frees it.
+static NSVGimage *DecodeShapes(Reader &in) {
+  NSVGimage *image = (NSVGimage *)calloc(1, sizeof(NSVGimage));
+  if (!image)
+    return nullptr;
+  image->width = in.F32();
+  image->height = in.F32();
+  float originX = in.F32();
+  float originY = in.F32();
+  float step = in.F32();
+
+  NSVGshape **nextShape = &image->shapes;
+  uint32_t shapeCount = in.Varint();
+  for (uint32_t s = 0; s < shapeCount && in.ok(); s++) {
+    NSVGshape *shape = (NSVGshape *)calloc(1, sizeof(NSVGshape));
+    if (!shape)
+      return Discard(image);
+    *nextShape = shape;
+    nextShape = &shape->next;
+
+    shape->fill.color = in.U32();
+    shape->stroke.color = in.U32();
+    shape->opacity = in.F32();
+    shape->strokeWidth = in.F32();
+    shape->miterLimit = in.F32();
+    shape->fill.type = (signed char)in.U8();
+    shape->stroke.type = (signed char)in.U8();
+    shape->fillRule = (char)in.U8();
+    shape->flags = in.U8();
+    shape->strokeLineJoin = (char)in.U8();
+    shape->strokeLineCap = (char)in.U8();
+    shape->paintOrder = in.U8();
+    // The encoder writes flat colors only; a gradient type would send the
+    // rasterizer to a null gradient.
+    if (!InRange(shape->fill.type, NSVG_PAINT_UNDEF, NSVG_PAINT_COLOR) ||
+        !InRange(shape->stroke.type, NSVG_PAINT_UNDEF, NSVG_PAINT_COLOR) ||
+        !InRange(shape->fillRule, NSVG_FILLRULE_NONZERO,
+                 NSVG_FILLRULE_EVENODD) ||
+        !InRange(shape->strokeLineJoin, NSVG_JOIN_MITER, NSVG_JOIN_BEVEL) ||
+        !InRange(shape->strokeLineCap, NSVG_CAP_BUTT, NSVG_CAP_SQUARE))
+      return Discard(image);
+    shape->bounds[0] = shape->bounds[1] = 1e30f;
+    shape->bounds[2] = shape->bounds[3] = -1e30f;
+
+    NSVGpath **nextPath = &shape->paths;
+    uint32_t pathCount = in.Varint();
+    for (uint32_t p = 0; p < pathCount && in.ok(); p++) {
+      uint32_t npts = in.Varint();
+      // Paths are a start point and three points per cubic; a corrupt count
+      // must not turn into a huge allocation.
+      if (npts > 0x100000 || (npts > 0 && (npts - 1) % 3 != 0))
+        return Discard(image);
+      NSVGpath *path = (NSVGpath *)calloc(1, sizeof(NSVGpath));
+      float *pts = (float *)malloc(sizeof(float) * 2 * std::max(npts, 1u));
+      if (!path || !pts) {
+        free(path);
+        free(pts);
+        return Discard(image);
+      }
+      *nextPath = path;
+      nextPath = &path->next;
+      path->pts = pts;
+      path->npts = (int)npts;
+      path->closed = (char)in.U8();
+
+      int32_t qx = 0, qy = 0;
+      auto point = [&](uint32_t i) {
+        pts[i * 2] = originX + (float)qx * step;
+        pts[i * 2 + 1] = originY + (float)qy * step;
+      };
+      if (npts > 0) {
+        qx = in.Svarint();
+        qy = in.Svarint();
+        point(0);
+      }
+      for (uint32_t i = 1; i + 2 < npts; i += 3) {
+        uint32_t tagged = in.Varint();
+        int32_t dx = (int32_t)(tagged >> 2) ^ -(int32_t)((tagged >> 1) & 1);
+        if (tagged & 1) {
+          // A line; nanosvg's lineTo puts the controls at thirds.
+          qx += dx;
+          qy += in.Svarint();
+          point(i + 2);
+          float *p = &pts[(i - 1) * 2];
+          float lx = p[6] - p[0], ly = p[7] - p[1];
+          p[2] = p[0] + lx / 3.0f;
+          p[3] = p[1] + ly / 3.0f;
+          p[4] = p[6] - lx / 3.0f;
+          p[5] = p[7] - ly / 3.0f;
+          continue;
+        }
+        qx += dx;
+        qy += in.Svarint();
+        point(i);
+        for (uint32_t j = i + 1; j <= i + 2; j++) {
+          qx += in.Svarint();
+          qy += in.Svarint();
+          point(j);
+        }
+      }
+      // The control point hull; a little looser than nanosvg's own.
+      path->bounds[0] = path->bounds[1] = 1e30f;
+      path->bounds[2] = path->bounds[3] = -1e30f;
+      for (uint32_t i = 0; i < npts; i++) {
+        path->bounds[0] = std::min(path->bounds[0], pts[i * 2]);
+        path->bounds[1] = std::min(path->bounds[1], pts[i * 2 + 1]);
+        path->bounds[2] = std::max(path->bounds[2], pts[i * 2]);
+        path->bounds[3] = std::max(path->bounds[3], pts[i * 2 + 1]);
+      }
+      shape->bounds[0] = std::min(shape->bounds[0], path->bounds[0]);
+      shape->bounds[1] = std::min(shape->bounds[1], path->bounds[1]);
+      shape->bounds[2] = std::max(shape->bounds[2], path->bounds[2]);
+      shape->bounds[3] = std::max(shape->bounds[3], path->bounds[3]);
+    }
+  }
+
+  return in.ok() ? image : Discard(image);
+}
+
+bool IconPack::Decode(int variation, const char *name, SvgModel *model) {
+  size_t size = 0;
+  bool svg = false;
+  const unsigned char *data = Find(variation, name, &size, &svg);
+  if (!data)
+    return false;
+  if (svg)
+    return model->LoadFromString(std::string((const char *)data, size).c_str());
+  Reader in(data, size);
+  NSVGimage *image = DecodeShapes(in);
+  if (!image)
+    return false;
+  model->Adopt(image);
+  return true;
+}
+
+bool IconPack::Encode(const NSVGimage *image, std::vector<unsigned char> *out) {
+  float minX = 1e30f, minY = 1e30f, maxX = -1e30f, maxY = -1e30f;
+  int shapeCount = 0;
+  for (NSVGshape *shape = image->shapes; shape; shape = shape->next) {
+    bool gradient = shape->fill.type > NSVG_PAINT_COLOR ||
+                    shape->stroke.type > NSVG_PAINT_COLOR;
+    if (gradient || shape->strokeDashCount > 0)
+      return false;
+    for (NSVGpath *path = shape->paths; path; path = path->next) {
+      for (int i = 0; i < path->npts; i++) {
+        minX = std::min(minX, path->pts[i * 2]);
+        minY = std::min(minY, path->pts[i * 2 + 1]);
+        maxX = std::max(maxX, path->pts[i * 2]);
+        maxY = std::max(maxY, path->pts[i * 2 + 1]);
+      }
+    }
+    shapeCount++;
+  }
+  float extent = std::max(std::max(fabsf(minX), fabsf(maxX)),
+                          std::max(fabsf(minY), fabsf(maxY)));
+  float step = 1.0f;
+  if (minX > maxX)
+    extent = 0.0f;
+  while (extent / step < kMaxSteps / 2 && step > 1.0f / 65536)
+    step /= 2;
+  while (extent / step >= kMaxSteps)
+    step *= 2;
+  minX = minY = 0.0f;
+
+  out->clear();
+  Writer w(out);
+  w.F32(image->width);
+  w.F32(image->height);
+  w.F32(minX);
+  w.F32(minY);
+  w.F32(step);
+  w.Varint((uint32_t)shapeCount);
+  for (NSVGshape *shape = image->shapes; shape; shape = shape->next) {
+    w.U32(shape->fill.color);
+    w.U32(shape->stroke.color);
+    w.F32(shape->opacity);
+    w.F32(shape->strokeWidth);
+    w.F32(shape->miterLimit);
+    w.U8((uint8_t)shape->fill.type);
+    w.U8((uint8_t)shape->stroke.type);
+    w.U8((uint8_t)shape->fillRule);
+    w.U8(shape->flags);
+    w.U8((uint8_t)shape->strokeLineJoin);
+    w.U8((uint8_t)shape->strokeLineCap);
+    w.U8(shape->paintOrder);
+
+    int pathCount = 0;
+    for (NSVGpath *path = shape->paths; path; path = path->next)
+      pathCount++;
+    w.Varint((uint32_t)pathCount);
+    for (NSVGpath *path = shape->paths; path; path = path->next) {
+      int npts = path->npts > 0 ? 1 + (path->npts - 1) / 3 * 3 : 0;
+      w.Varint((uint32_t)npts);
+      w.U8((uint8_t)path->closed);
+      const float *pts = path->pts;
+      int32_t qx = 0, qy = 0;
+      // Delta from the previous point, or for a line's end, from its start.
+      auto delta = [&](int i, int32_t *dx, int32_t *dy) {
+        int32_t x = (int32_t)lroundf((pts[i * 2] - minX) / step);
+        int32_t y = (int32_t)lroundf((pts[i * 2 + 1] - minY) / step);
+        *dx = x - qx;
+        *dy = y - qy;
+        qx = x;
+        qy = y;
+      };
+      int32_t dx, dy;
+      if (npts > 0) {
+        delta(0, &dx, &dy);
+        w.Svarint(dx);
+        w.Svarint(dy);
+      }
+      for (int i = 1; i + 2 < npts; i += 3) {
+        const float *p = &pts[(i - 1) * 2];
+        // nanosvg turns lines into cubics, whose controls the decoder can
+        // recreate; the low bit of the first varint marks them.
+        float lx = p[6] - p[0], ly = p[7] - p[1];
+        float tolerance = step * 0.5f;
+        bool line = fabsf(p[2] - (p[0] + lx / 3.0f)) < tolerance &&
+                    fabsf(p[3] - (p[1] + ly / 3.0f)) < tolerance &&
+                    fabsf(p[4] - (p[6] - lx / 3.0f)) < tolerance &&
+                    fabsf(p[5] - (p[7] - ly / 3.0f)) < tolerance;
+        delta(line ? i + 2 : i, &dx, &dy);
+        uint32_t zigzag = ((uint32_t)dx << 1) ^ (uint32_t)(dx >> 31);
+        w.Varint(zigzag << 1 | (line ? 1 : 0));
+        w.Svarint(dy);
+        if (line)
+          continue;
+        for (int j = i + 1; j <= i + 2; j++) {
+          delta(j, &dx, &dy);
+          w.Svarint(dx);
+          w.Svarint(dy);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool IconPack::Write(const std::string &path,
+                     std::vector<IconPackEntry> entries) {
+  std::sort(entries.begin(), entries.end(),
+            [](const IconPackEntry &a, const IconPackEntry &b) {
+              if (a.variation != b.variation)
+                return a.variation < b.variation;
+              return a.name < b.name;
+            });
+
+  PackHeader header = {};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kFormatVersion;
+  header.entryCount = (uint32_t)entries.size();
+  for (int v = 0; v < kVariations; v++) {
+    header.variationFirst[v] = (uint32_t)(
+        std::lower_bound(entries.begin(), entries.end(), v,
+                         [](const IconPackEntry &e, int value) {
+                           return e.variation < value;
+                         }) -
+        entries.begin());
+  }
+
+  // Header, records, then every name, then every entry's data.
+  std::vector<PackRecord> records(entries.size());
+  uint64_t offset = sizeof(PackHeader) + records.size() * sizeof(PackRecord);
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (entries[i].name.size() > 0xffff)
+      return false;
+    records[i].nameOffset = (uint32_t)offset;
+    records[i].nameLength = (uint16_t)entries[i].name.size();
+    offset += entries[i].name.size();
+  }
+  for (size_t i = 0; i < entries.size(); i++) {
+    records[i].dataOffset = (uint32_t)offset;
+    records[i].dataSize = (uint32_t)entries[i].data.size();
+    records[i].svg = entries[i].svg ? 1 : 0;
+    offset += entries[i].data.size();
+  }
+  if (offset > 0xffffffffull)
+    return false;
+
+  std::string temporary = path + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file)
+      return false;
+    file.write((const char *)&header, sizeof(header));
+    file.write((const char *)records.data(),
+               (std::streamsize)(records.size() * sizeof(PackRecord)));
+    for (const IconPackEntry &entry : entries)
+      file.write(entry.name.data(), (std::streamsize)entry.name.size());
+    for (const IconPackEntry &entry : entries)
+      file.write((const char *)entry.data.data(),
+                 (std::streamsize)entry.data.size());
+    if (!file)
+      return false;
+  }
+  std::remove(path.c_str());
+  return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+} // namespace raym3
@@ -0,0 +1,49 @@
+#include "raym3/rendering/MappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace raym3 {
+
+MappedFile::MappedFile(const std::string &path) {
+#ifndef _WIN32
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    void *mapped =
+        mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped != MAP_FAILED) {
+      data_ = (const unsigned char *)mapped;
+      size_ = (size_t)info.st_size;
+    }
+  }
+  close(fd);
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file)
+    return;
+  copy_.resize((size_t)file.tellg());
+  file.seekg(0);
+  if (file.read((char *)copy_.data(), (std::streamsize)copy_.size())) {
+    data_ = copy_.data();
+    size_ = copy_.size();
+  }
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (data_)
+    munmap((void *)data_, size_);
+#endif
+}
+
+} // namespace raym3
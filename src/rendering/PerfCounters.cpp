@@ -0,0 +1,124 @@
+#include "raym3/rendering/PerfCounters.h"
+#include "raym3/rendering/DamageTracker.h"
+#include "raym3/rendering/DrawCommandBuffer.h"
+#include "raym3/rendering/RenderBackend.h"
+#include "raym3/rendering/Renderer.h"
+#include <algorithm>
+#include <cstdio>
+
+#if RAYM3_COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#endif
+
+namespace raym3 {
+
+PerfStats PerfCounters::frame_;
+PerfStats PerfCounters::lastFrame_;
+bool PerfCounters::hudEnabled_ = false;
+std::chrono::steady_clock::time_point PerfCounters::frameStart_;
+int64_t PerfCounters::allocationsAtStart_ = 0;
+int64_t PerfCounters::allocatedBytesAtStart_ = 0;
+
+#if RAYM3_COUNT_ALLOCATIONS
+// Process-wide totals, fed by the replacement operator new below. Frames
+// report the difference between BeginFrame() and EndFrame(), so allocations
+// made by other threads in that window are included.
+static std::atomic<int64_t> s_allocations{0};
+static std::atomic<int64_t> s_allocatedBytes{0};
+#endif
+
+void PerfCounters::BeginFrame() {
+  frame_ = {};
+  frameStart_ = std::chrono::steady_clock::now();
+#if RAYM3_COUNT_ALLOCATIONS
+  allocationsAtStart_ = s_allocations.load(std::memory_order_relaxed);
+  allocatedBytesAtStart_ = s_allocatedBytes.load(std::memory_order_relaxed);
+#endif
+}
+
+void PerfCounters::EndFrame() {
+  const DrawBatchStats &draw = DrawCommandBuffer::GetFrameStats();
+  frame_.drawCommands = draw.commands;
+  frame_.drawCalls = draw.batches;
+  frame_.vertices = draw.vertices;
+  frame_.flushes = draw.flushes;
+#if RAYM3_COUNT_ALLOCATIONS
+  frame_.allocations =
+      s_allocations.load(std::memory_order_relaxed) - allocationsAtStart_;
+  frame_.allocatedBytes =
+      s_allocatedBytes.load(std::memory_order_relaxed) - allocatedBytesAtStart_;
+#endif
+  frame_.frameMs = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - frameStart_)
+                       .count();
+  lastFrame_ = frame_;
+}
+
+void PerfCounters::DrawHud() {
+  if (!hudEnabled_)
+    return;
+
+  const PerfStats &s = lastFrame_;
+  char lines[10][96];
+  int count = 0;
+  snprintf(lines[count++], sizeof(lines[0]), "Frame %.2f ms", s.frameMs);
+  snprintf(lines[count++], sizeof(lines[0]),
+           "Draw %d calls, %d verts, %d flushes, %d cmds", s.drawCalls,
+           s.vertices, s.flushes, s.drawCommands);
+  snprintf(lines[count++], sizeof(lines[0]),
+           "Text %d measures (%d cached), %d draws", s.textMeasures,
+           s.textCacheHits, s.textDraws);
+  snprintf(lines[count++], sizeof(lines[0]),
+           "Fonts %d hit, %d miss, %d baked", s.fontCacheHits,
+           s.fontCacheMisses, s.fontRasterizations);
+  snprintf(lines[count++], sizeof(lines[0]),
+           "Icons %d hit, %d miss, %d baked", s.iconCacheHits,
+           s.iconCacheMisses, s.iconRasterizations);
+  snprintf(lines[count++], sizeof(lines[0]), "Shadows %d hit, %d miss",
+           s.shadowCacheHits, s.shadowCacheMisses);
+  snprintf(lines[count++], sizeof(lines[0]),
+           "Layout %d nodes, %d passes, %.2f ms", s.layoutNodes,
+           s.layoutPasses, s.layoutMs);
+  snprintf(lines[count++], sizeof(lines[0]),
+           "Input %d blocking, %d queued", s.blockingRegions, s.renderQueue);
+  if (s.allocations >= 0) {
+    snprintf(lines[count++], sizeof(lines[0]), "Heap %lld allocs, %.1f KB",
+             (long long)s.allocations, s.allocatedBytes / 1024.0);
+  } else {
+    snprintf(lines[count++], sizeof(lines[0]), "Heap not counted");
+  }
+
+  const float fontSize = 12.0f;
+  const float lineHeight = 16.0f;
+  float width = 0.0f;
+  for (int i = 0; i < count; i++)
+    width = std::max(width, Renderer::MeasureText(lines[i], fontSize).x);
+
+  Rectangle screen = RenderBackend::GetScreenBounds();
+  Rectangle panel = {screen.width - width - 20.0f, 8.0f, width + 12.0f,
+                     count * lineHeight + 8.0f};
+  Renderer::DrawRectangle(panel, (Color){0, 0, 0, 180});
+  for (int i = 0; i < count; i++) {
+    Vector2 position = {panel.x + 6.0f, panel.y + 4.0f + i * lineHeight};
+    Renderer::DrawText(lines[i], position, fontSize, WHITE);
+  }
+  DamageTracker::InvalidateOverlay(panel);
+}
+
+} // namespace raym3
+
+#if RAYM3_COUNT_ALLOCATIONS
+// Global replacements. The array and nothrow forms forward here by default.
+void *operator new(std::size_t size) {
+  raym3::s_allocations.fetch_add(1, std::memory_order_relaxed);
+  raym3::s_allocatedBytes.fetch_add((int64_t)size, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+#endif
@@ -0,0 +1,211 @@
+#include "raym3/rendering/PrewarmManifest.h"
+#include "raym3/fonts/FontManager.h"
+#include "raym3/fonts/GlyphAtlas.h"
+#include "raym3/rendering/IconAtlas.h"
+#include "raym3/rendering/SvgRenderer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace raym3 {
+
+bool PrewarmManifest::recording_ = false;
+PrewarmManifest PrewarmManifest::recorded_;
+std::unordered_set<uint64_t> PrewarmManifest::recordedKeys_;
+
+// In FontWeight order.
+static const char *kWeightNames[] = {"thin",   "light", "regular",
+                                     "medium", "bold",  "black"};
+
+static bool ParseVariation(const std::string &text, IconVariation *out) {
+  for (int v = 0; v < 5; v++) {
+    if (text == SvgRenderer::GetVariationFolder((IconVariation)v)) {
+      *out = (IconVariation)v;
+      return true;
+    }
+  }
+  return false;
+}
+
+// "24" or "32x24".
+static bool ParseIconSize(const std::string &text, int *width, int *height) {
+  char *end = nullptr;
+  long w = strtol(text.c_str(), &end, 10);
+  long h = w;
+  if (*end == 'x')
+    h = strtol(end + 1, &end, 10);
+  if (*end != '\0' || w <= 0 || h <= 0 || w > 0xffff || h > 0xffff)
+    return false;
+  *width = (int)w;
+  *height = (int)h;
+  return true;
+}
+
+static bool ParseWeight(const std::string &text, FontWeight *out) {
+  for (int w = 0; w < (int)std::size(kWeightNames); w++) {
+    if (text == kWeightNames[w]) {
+      *out = (FontWeight)w;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PrewarmManifest::Load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) {
+    std::cerr << "Prewarm manifest not found: " << path << std::endl;
+    return false;
+  }
+  std::stringstream text;
+  text << file.rdbuf();
+  return Parse(text.str());
+}
+
+bool PrewarmManifest::Parse(const std::string &text) {
+  icons.clear();
+  fonts.clear();
+  std::istringstream lines(text);
+  std::string line;
+  int number = 0;
+  while (std::getline(lines, line)) {
+    number++;
+    std::istringstream fields(line);
+    std::string kind;
+    if (!(fields >> kind) || kind[0] == '#')
+      continue;
+
+    std::string style;
+    int size = 0;
+    bool valid = false;
+    if (kind == "icon") {
+      PrewarmIcon icon;
+      std::string sizeText;
+      int height = 0;
+      if (fields >> style >> sizeText >> icon.name &&
+          ParseIconSize(sizeText, &size, &height) &&
+          ParseVariation(style, &icon.variation)) {
+        icon.size = size;
+        icon.height = height == size ? 0 : height;
+        icons.push_back(std::move(icon));
+        valid = true;
+      }
+    } else if (kind == "font") {
+      PrewarmFont font;
+      if (fields >> style >> size && size > 0 &&
+          ParseWeight(style, &font.weight)) {
+        font.size = size;
+        fonts.push_back(font);
+        valid = true;
+      }
+    }
+    if (!valid)
+      std::cerr << "Prewarm manifest line " << number
+                << " skipped: " << line << std::endl;
+  }
+  return true;
+}
+
+std::string PrewarmManifest::ToString() const {
+  std::ostringstream out;
+  out << "# raym3 prewarm manifest\n";
+  for (const PrewarmIcon &icon : icons) {
+    out << "icon " << SvgRenderer::GetVariationFolder(icon.variation) << " "
+        << icon.size;
+    if (icon.height > 0 && icon.height != icon.size)
+      out << "x" << icon.height;
+    out << " " << icon.name << "\n";
+  }
+  for (const PrewarmFont &font : fonts)
+    out << "font " << kWeightNames[(int)font.weight] << " " << font.size
+        << "\n";
+  return out.str();
+}
+
+bool PrewarmManifest::Save(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file)
+    return false;
+  file << ToString();
+  return (bool)file;
+}
+
+void PrewarmManifest::Bake(const PrewarmCallback &progress) const {
+  PrewarmProgress state;
+  state.total = (int)(icons.size() + fonts.size());
+  if (progress)
+    progress(state);
+  auto report = [&](int done) {
+    if (progress && done != state.done) {
+      state.done = done;
+      progress(state);
+    }
+  };
+
+  // Icons finished while baking land in pages created here, which are
+  // uploaded once each at the end.
+  IconAtlas::BeginBatch();
+
+  // Entries already loaded, or baked here because there are no workers;
+  // the Prewarm() calls return false or 0 for these.
+  int baked = 0;
+  for (const PrewarmIcon &icon : icons) {
+    IconHandle handle =
+        SvgRenderer::GetIconHandle(icon.name.c_str(), icon.variation);
+    int height = icon.height > 0 ? icon.height : icon.size;
+    if (!SvgRenderer::Prewarm(handle, (float)icon.size, (float)height))
+      report(++baked);
+  }
+  for (const PrewarmFont &font : fonts) {
+    if (FontManager::Prewarm(font.weight, {(float)font.size}) == 0)
+      report(++baked);
+  }
+
+  // The pools may also hold jobs queued before the bake.
+  int queued = state.total - baked;
+  while (true) {
+    int running = SvgRenderer::GetRasterizingIcons() +
+                  FontManager::GetRasterizingGlyphJobs();
+    report(baked + queued - std::min(running, queued));
+    if (running == 0)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  SvgRenderer::WaitForPendingIcons();
+  FontManager::BeginFrame();
+  // Glyphs are uploaded when the texture is next asked for; do it now.
+  GlyphAtlas::GetTexture();
+  IconAtlas::EndBatch();
+  report(state.total);
+}
+
+void PrewarmManifest::StartRecording() {
+  recorded_ = {};
+  recordedKeys_.clear();
+  recording_ = true;
+}
+
+void PrewarmManifest::RecordIcon(int iconId, const std::string &name,
+                                 IconVariation variation, int width,
+                                 int height) {
+  // Raster sizes fit 16 bits each.
+  uint64_t key = (uint64_t)iconId << 32 | (uint64_t)width << 16 |
+                 (uint32_t)height;
+  if (recordedKeys_.insert(key).second)
+    recorded_.icons.push_back(
+        {name, variation, width, height == width ? 0 : height});
+}
+
+void PrewarmManifest::RecordFont(FontWeight weight, int size) {
+  // Icon ids are below 2^31, so the top bit keeps the key spaces apart.
+  uint64_t key = 1ull << 63 | (uint64_t)weight << 32 | (uint32_t)size;
+  if (recordedKeys_.insert(key).second)
+    recorded_.fonts.push_back({weight, size});
+}
+
+} // namespace raym3
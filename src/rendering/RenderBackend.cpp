@@ -0,0 +1,191 @@
+#include "raym3/rendering/RenderBackend.h"
+#include "raym3/rendering/SdfRenderer.h"
+#include <rlgl.h>
+
+namespace raym3 {
+
+static RaylibBackend s_raylibBackend;
+
+RenderBackend *RenderBackend::current_ = &s_raylibBackend;
+
+void RenderBackend::Set(RenderBackend *backend) {
+  current_ = backend ? backend : &s_raylibBackend;
+}
+
+bool RaylibBackend::SupportsSdf() { return SdfRenderer::IsSupported(); }
+
+bool RaylibBackend::SupportsSdfText() {
+  return SdfRenderer::IsTextSupported();
+}
+
+Texture2D RaylibBackend::LoadTexture(const Image &image) {
+  return LoadTextureFromImage(image);
+}
+
+void RaylibBackend::UnloadTexture(Texture2D texture) {
+  ::UnloadTexture(texture);
+}
+
+void RaylibBackend::SetTextureFilter(Texture2D texture, int filter) {
+  ::SetTextureFilter(texture, filter);
+}
+
+void RaylibBackend::UpdateTexture(Texture2D texture, Rectangle region,
+                                  const void *pixels) {
+  UpdateTextureRec(texture, region, pixels);
+}
+
+void RaylibBackend::SetScissor(const Rectangle *bounds) {
+  if (!bounds) {
+    EndScissorMode();
+    return;
+  }
+  BeginScissorMode((int)bounds->x, (int)bounds->y, (int)bounds->width,
+                   (int)bounds->height);
+}
+
+bool RaylibBackend::BeginRetained() {
+  int width = ::GetScreenWidth();
+  int height = ::GetScreenHeight();
+  bool intact = retained_.id != 0 && retained_.texture.width == width &&
+                retained_.texture.height == height;
+  if (!intact) {
+    ReleaseRetained();
+    retained_ = LoadRenderTexture(width, height);
+  }
+  BeginTextureMode(retained_);
+  return intact;
+}
+
+void RaylibBackend::ClearRegion(Rectangle region, Color color) {
+  // glClear honours the scissor box, and BeginScissorMode() accounts for the
+  // render texture's flipped origin.
+  BeginScissorMode((int)region.x, (int)region.y, (int)region.width,
+                   (int)region.height);
+  ClearBackground(color);
+  EndScissorMode();
+}
+
+void RaylibBackend::EndRetained() {
+  EndTextureMode();
+  float width = (float)retained_.texture.width;
+  float height = (float)retained_.texture.height;
+  // Render textures are stored bottom-up.
+  DrawTexturePro(retained_.texture, {0, 0, width, -height},
+                 {0, 0, width, height}, {0, 0}, 0.0f, WHITE);
+}
+
+void RaylibBackend::ReleaseRetained() {
+  if (retained_.id == 0)
+    return;
+  UnloadRenderTexture(retained_);
+  retained_ = {};
+}
+
+void RaylibBackend::BeginBatch() { quadTexture_ = 0; }
+
+void RaylibBackend::EndBatch() {
+  EndQuads();
+  SdfRenderer::Draw();
+}
+
+void RaylibBackend::EndQuads() {
+  if (quadTexture_ == 0)
+    return;
+  rlEnd();
+  rlSetTexture(0);
+  // Switching shader draws the pending quads with the SDF shader first.
+  if (quadSdf_)
+    EndShaderMode();
+  quadTexture_ = 0;
+  quadSdf_ = false;
+}
+
+void RaylibBackend::EmitQuads(const DrawCommand &cmd,
+                              const TexturedQuad *quads) {
+  const float invW = 1.0f / cmd.quads.textureWidth;
+  const float invH = 1.0f / cmd.quads.textureHeight;
+  const Color c = cmd.color;
+  for (uint32_t q = 0; q < cmd.quads.quadCount; q++) {
+    const TexturedQuad &quad = quads[cmd.quads.firstQuad + q];
+    float u0 = quad.source.x * invW;
+    float v0 = quad.source.y * invH;
+    float u1 = (quad.source.x + quad.source.width) * invW;
+    float v1 = (quad.source.y + quad.source.height) * invH;
+    Rectangle d = quad.dest;
+
+    rlCheckRenderBatchLimit(4);
+    rlColor4ub(c.r, c.g, c.b, c.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    rlTexCoord2f(u0, v0);
+    rlVertex2f(d.x, d.y);
+    rlTexCoord2f(u0, v1);
+    rlVertex2f(d.x, d.y + d.height);
+    rlTexCoord2f(u1, v1);
+    rlVertex2f(d.x + d.width, d.y + d.height);
+    rlTexCoord2f(u1, v0);
+    rlVertex2f(d.x + d.width, d.y);
+  }
+}
+
+void RaylibBackend::Execute(const DrawCommand &cmd,
+                            const TexturedQuad *quads) {
+  if (cmd.type == DrawCommandType::Quads ||
+      cmd.type == DrawCommandType::SdfQuads) {
+    bool sdf = cmd.type == DrawCommandType::SdfQuads;
+    if (quadTexture_ != cmd.textureId || quadSdf_ != sdf) {
+      EndQuads();
+      if (sdf)
+        BeginShaderMode(SdfRenderer::GetTextShader());
+      rlSetTexture(cmd.textureId);
+      rlBegin(RL_QUADS);
+      quadTexture_ = cmd.textureId;
+      quadSdf_ = sdf;
+    }
+    EmitQuads(cmd, quads);
+    return;
+  }
+  EndQuads();
+
+  switch (cmd.type) {
+  case DrawCommandType::Rectangle:
+    DrawRectangleRec(cmd.rect.rec, cmd.color);
+    break;
+  case DrawCommandType::RectangleLines:
+    DrawRectangleLinesEx(cmd.rect.rec, cmd.rect.lineWidth, cmd.color);
+    break;
+  case DrawCommandType::RoundedRectangle:
+    DrawRectangleRounded(cmd.rect.rec, cmd.rect.roundness, cmd.segments,
+                         cmd.color);
+    break;
+  case DrawCommandType::RoundedRectangleLines:
+#ifdef PLATFORM_ANDROID
+    DrawRectangleRoundedLinesEx(cmd.rect.rec, cmd.rect.roundness, cmd.segments,
+                                cmd.rect.lineWidth, cmd.color);
+#else
+    DrawRectangleRoundedLines(cmd.rect.rec, cmd.rect.roundness, cmd.segments,
+                              cmd.color);
+#endif
+    break;
+  case DrawCommandType::Ring:
+    DrawRing(cmd.ring.center, cmd.ring.innerRadius, cmd.ring.outerRadius,
+             cmd.ring.startAngle, cmd.ring.endAngle, cmd.segments, cmd.color);
+    break;
+  case DrawCommandType::Line:
+    DrawLineEx(cmd.line.start, cmd.line.end, cmd.line.thickness, cmd.color);
+    break;
+  case DrawCommandType::Triangle:
+    DrawTriangle(cmd.triangle.v1, cmd.triangle.v2, cmd.triangle.v3, cmd.color);
+    break;
+  case DrawCommandType::SdfRectangle:
+    // Collected and drawn as one call at EndBatch().
+    SdfRenderer::Add({cmd.sdf.rec, cmd.sdf.radius, cmd.sdf.lineWidth,
+                      cmd.sdf.softness, cmd.color});
+    break;
+  case DrawCommandType::Quads:
+  case DrawCommandType::SdfQuads:
+    break;
+  }
+}
+
+} // namespace raym3
@@ -1,31 +1,99 @@
 #include "raym3/rendering/Renderer.h"
 #include "raym3/fonts/FontManager.h"
+#include "raym3/rendering/DrawCommandBuffer.h"
+#include "raym3/rendering/PerfCounters.h"
+#include "raym3/rendering/RenderBackend.h"
+#include "raym3/rendering/ShadowCache.h"
+#include "raym3/rendering/TextMeasureCache.h"
 #include "raym3/styles/Theme.h"
+#include <algorithm>
 #include <cmath>
 
 namespace raym3 {
 
+// raylib's default vertical gap between lines of a multi-line string.
+static constexpr float kTextLineSpacing = 2.0f;
+
+static DrawCommand MakeCommand(DrawCommandType type, Rectangle bounds,
+                               Color color) {
+  DrawCommand cmd = {};
+  cmd.type = type;
+  cmd.textureId = GetShapesTexture().id;
+  cmd.color = color;
+  cmd.bounds = bounds;
+  return cmd;
+}
+
+static void SubmitSdf(Rectangle rec, float radius, float lineWidth,
+                      float softness, Color color) {
+  float pad = 1.0f + lineWidth + 3.0f * softness;
+  Rectangle bounds = {rec.x - pad, rec.y - pad, rec.width + 2.0f * pad,
+                      rec.height + 2.0f * pad};
+  DrawCommand cmd = MakeCommand(DrawCommandType::SdfRectangle, bounds, color);
+  cmd.textureId = 0;
+  cmd.sdf = {rec, std::max(radius, 0.0f), lineWidth, softness};
+  DrawCommandBuffer::Submit(cmd);
+}
+
+static Rectangle PointsBounds(const Vector2 *points, int count, float pad) {
+  float minX = points[0].x, maxX = points[0].x;
+  float minY = points[0].y, maxY = points[0].y;
+  for (int i = 1; i < count; i++) {
+    minX = std::min(minX, points[i].x);
+    maxX = std::max(maxX, points[i].x);
+    minY = std::min(minY, points[i].y);
+    maxY = std::max(maxY, points[i].y);
+  }
+  return {minX - pad, minY - pad, maxX - minX + 2.0f * pad,
+          maxY - minY + 2.0f * pad};
+}
+
+bool Renderer::sdfShapes_ = false;
+
+void Renderer::SetSdfShapes(bool enabled) { sdfShapes_ = enabled; }
+
+bool Renderer::IsSdfShapesEnabled() { return sdfShapes_; }
+
+bool Renderer::UseSdf() {
+  return sdfShapes_ && RenderBackend::Get()->SupportsSdf();
+}
+
 void Renderer::DrawRoundedRectangle(Rectangle bounds, float cornerRadius,
                                     Color color) {
+  if (UseSdf()) {
+    SubmitSdf(bounds, cornerRadius, 0.0f, 0.0f, color);
+    return;
+  }
   float minDim = std::min(bounds.width, bounds.height);
   // Raylib expects 1.0 for full rounding (radius = minDim/2).
   // So we need to normalize cornerRadius against minDim/2.
   float roundness = (minDim > 0) ? (2.0f * cornerRadius) / minDim : 0.0f;
   roundness = std::clamp(roundness, 0.0f, 1.0f);
-  DrawRectangleRounded(bounds, roundness, 16,
-                       color); // Increased segments for smoothness
+  DrawCommand cmd =
+      MakeCommand(DrawCommandType::RoundedRectangle, bounds, color);
+  cmd.segments = 16; // Increased segments for smoothness
+  cmd.rect = {bounds, roundness, 0.0f};
+  DrawCommandBuffer::Submit(cmd);
 }
 
 void Renderer::DrawRoundedRectangleEx(Rectangle bounds, float cornerRadius,
                                       Color color, float lineWidth) {
+  if (UseSdf()) {
+    SubmitSdf(bounds, cornerRadius, lineWidth, 0.0f, color);
+    return;
+  }
   float minDim = std::min(bounds.width, bounds.height);
   float roundness = (minDim > 0) ? (2.0f * cornerRadius) / minDim : 0.0f;
   roundness = std::clamp(roundness, 0.0f, 1.0f);
-#ifdef PLATFORM_ANDROID
-  DrawRectangleRoundedLinesEx(bounds, roundness, 16, lineWidth, color);
-#else
-  DrawRectangleRoundedLines(bounds, roundness, 16, color);
-#endif
+  // Rounded outlines are stroked outside the rectangle.
+  Rectangle outer = {bounds.x - lineWidth, bounds.y - lineWidth,
+                     bounds.width + 2.0f * lineWidth,
+                     bounds.height + 2.0f * lineWidth};
+  DrawCommand cmd =
+      MakeCommand(DrawCommandType::RoundedRectangleLines, outer, color);
+  cmd.segments = 16;
+  cmd.rect = {bounds, roundness, lineWidth};
+  DrawCommandBuffer::Submit(cmd);
 }
 
 void Renderer::DrawElevatedRectangle(Rectangle bounds, float cornerRadius,
@@ -40,6 +108,22 @@ void Renderer::DrawShadow(Rectangle bounds, float cornerRadius, int elevation) {
   Color shadowColor = Theme::GetElevationColor(elevation);
   float shadowOffset = Theme::GetElevationShadow(elevation);
 
+  // SDF and cached shadows are one blurred shape at the layers' mean offset,
+  // with the peak opacity of the three stacked tessellated layers below.
+  float blurOffset = shadowOffset * 2.0f / 3.0f;
+  Rectangle blurBounds = {bounds.x + blurOffset, bounds.y + blurOffset,
+                          bounds.width, bounds.height};
+  float softness = std::max(shadowOffset * 0.5f, 1.0f);
+  Color blurColor = ColorAlpha(shadowColor, 1.0f - std::pow(0.9f, 3.0f));
+  if (UseSdf()) {
+    SubmitSdf(blurBounds, cornerRadius, 0.0f, softness, blurColor);
+    return;
+  }
+  if (ShadowCache::IsEnabled() &&
+      ShadowCache::DrawShadow(blurBounds, cornerRadius, elevation, softness,
+                              blurColor))
+    return;
+
   // User request: "shadownshould be more visible"
   // The current implementation is a simple offset rectangle which looks flat.
   // To make it more visible/realistic without shaders, we can:
@@ -78,6 +162,79 @@ void Renderer::DrawText(const char *text, Vector2 position, float fontSize,
   DrawTextEx(font, text, position, fontSize, 0, color);
 }
 
+void Renderer::DrawTextEx(Font font, const char *text, Vector2 position,
+                          float fontSize, float spacing, Color color) {
+  if (!text || text[0] == '\0')
+    return;
+  FontManager::EnsureGlyphs(font, text);
+  if (font.texture.id == 0)
+    font = GetFontDefault();
+  // Without a GL context raylib's default font is never loaded.
+  if (font.texture.id == 0 || !font.glyphs)
+    return;
+  PerfCounters::Frame().textDraws++;
+
+  // Same glyph placement as raylib's DrawTextEx/DrawTextCodepoint, but the
+  // quads are recorded as one run so the whole string is a single command.
+  float scaleFactor = fontSize / (float)font.baseSize;
+  float padding = (float)font.glyphPadding;
+  float offsetX = 0.0f;
+  float offsetY = 0.0f;
+  uint32_t firstQuad = DrawCommandBuffer::QuadCount();
+  float minX = position.x, minY = position.y;
+  float maxX = position.x, maxY = position.y;
+
+  for (int i = 0; text[i] != '\0';) {
+    int byteCount = 0;
+    int codepoint = GetCodepointNext(&text[i], &byteCount);
+    int index = FontManager::GetGlyphIndex(font, codepoint);
+    i += byteCount;
+
+    if (codepoint == '\n') {
+      offsetY += fontSize + kTextLineSpacing;
+      offsetX = 0.0f;
+      continue;
+    }
+
+    const GlyphInfo &glyph = font.glyphs[index];
+    const Rectangle &rec = font.recs[index];
+    if (codepoint != ' ' && codepoint != '\t') {
+      Rectangle dest = {
+          position.x + offsetX + (glyph.offsetX - padding) * scaleFactor,
+          position.y + offsetY + (glyph.offsetY - padding) * scaleFactor,
+          (rec.width + 2.0f * padding) * scaleFactor,
+          (rec.height + 2.0f * padding) * scaleFactor};
+      Rectangle source = {rec.x - padding, rec.y - padding,
+                          rec.width + 2.0f * padding,
+                          rec.height + 2.0f * padding};
+      DrawCommandBuffer::AddQuad(source, dest);
+      minX = std::min(minX, dest.x);
+      minY = std::min(minY, dest.y);
+      maxX = std::max(maxX, dest.x + dest.width);
+      maxY = std::max(maxY, dest.y + dest.height);
+    }
+
+    if (glyph.advanceX == 0)
+      offsetX += rec.width * scaleFactor + spacing;
+    else
+      offsetX += (float)glyph.advanceX * scaleFactor + spacing;
+  }
+
+  uint32_t quadCount = DrawCommandBuffer::QuadCount() - firstQuad;
+  if (quadCount == 0)
+    return;
+
+  DrawCommandType type = FontManager::IsSdfFont(font)
+                             ? DrawCommandType::SdfQuads
+                             : DrawCommandType::Quads;
+  DrawCommand cmd =
+      MakeCommand(type, {minX, minY, maxX - minX, maxY - minY}, color);
+  cmd.textureId = font.texture.id;
+  cmd.quads = {firstQuad, quadCount, (float)font.texture.width,
+               (float)font.texture.height};
+  DrawCommandBuffer::Submit(cmd);
+}
+
 void Renderer::DrawTextCentered(const char *text, Rectangle bounds,
                                 float fontSize, Color color,
                                 FontWeight weight) {
@@ -91,9 +248,149 @@ void Renderer::DrawTextCentered(const char *text, Rectangle bounds,
 }
 
 Vector2 Renderer::MeasureText(const char *text, float fontSize,
-                              FontWeight weight) {
+                              FontWeight weight, uint64_t textHash) {
   Font font = Theme::GetFont(fontSize, weight);
-  return MeasureTextEx(font, text, fontSize, 0);
+  return MeasureTextEx(font, text, fontSize, 0, textHash);
+}
+
+Vector2 Renderer::MeasureTextEx(Font font, const char *text, float fontSize,
+                                float spacing, uint64_t textHash) {
+  PerfCounters::Frame().textMeasures++;
+  if (!text || text[0] == '\0')
+    return {0, 0};
+
+  bool cached = TextMeasureCache::IsEnabled();
+  uint64_t fontId = FontManager::GetFontId(font);
+  if (cached) {
+    if (textHash == 0)
+      textHash = TextMeasureCache::Hash(text);
+    Vector2 size;
+    if (TextMeasureCache::Lookup(fontId, textHash, fontSize, spacing, &size))
+      return size;
+  }
+
+  FontManager::EnsureGlyphs(font, text);
+  // Without a texture raylib reports zero; match it, and don't remember that.
+  if (font.texture.id == 0 || !font.glyphs)
+    return {0, 0};
+
+  // raylib's MeasureTextEx, with FontManager's glyph lookup in place of its
+  // linear scan.
+  float scaleFactor = fontSize / (float)font.baseSize;
+  float lineWidth = 0.0f;
+  float maxWidth = 0.0f;
+  float height = fontSize;
+  int lineChars = 0;
+  int maxChars = 0;
+  for (int i = 0; text[i] != '\0';) {
+    int byteCount = 0;
+    int codepoint = GetCodepointNext(&text[i], &byteCount);
+    i += byteCount;
+    lineChars++;
+
+    if (codepoint == '\n') {
+      maxWidth = std::max(maxWidth, lineWidth);
+      lineWidth = 0.0f;
+      lineChars = 0;
+      height += fontSize + kTextLineSpacing;
+    } else {
+      int index = FontManager::GetGlyphIndex(font, codepoint);
+      const GlyphInfo &glyph = font.glyphs[index];
+      if (glyph.advanceX > 0)
+        lineWidth += (float)glyph.advanceX;
+      else
+        lineWidth += font.recs[index].width + (float)glyph.offsetX;
+    }
+    maxChars = std::max(maxChars, lineChars);
+  }
+  maxWidth = std::max(maxWidth, lineWidth);
+
+  Vector2 size = {maxWidth * scaleFactor + (float)(maxChars - 1) * spacing,
+                  height};
+  // A stand-in font (glyphs still rasterizing) measures only approximately.
+  if (cached && FontManager::GetFontId(font) == fontId)
+    TextMeasureCache::Store(fontId, textHash, fontSize, spacing, size);
+  return size;
+}
+
+void Renderer::DrawRectangle(Rectangle bounds, Color color) {
+  DrawCommand cmd = MakeCommand(DrawCommandType::Rectangle, bounds, color);
+  cmd.rect = {bounds, 0.0f, 0.0f};
+  DrawCommandBuffer::Submit(cmd);
+}
+
+void Renderer::DrawRectangleLines(Rectangle bounds, float lineWidth,
+                                  Color color) {
+  DrawCommand cmd =
+      MakeCommand(DrawCommandType::RectangleLines, bounds, color);
+  cmd.rect = {bounds, 0.0f, lineWidth};
+  DrawCommandBuffer::Submit(cmd);
+}
+
+void Renderer::DrawCircle(Vector2 center, float radius, Color color) {
+  // Matches raylib's DrawCircleV tessellation.
+  DrawRing(center, 0.0f, radius, 0.0f, 360.0f, 36, color);
+}
+
+void Renderer::DrawCircleSector(Vector2 center, float radius,
+                                float startAngle, float endAngle, int segments,
+                                Color color) {
+  DrawRing(center, 0.0f, radius, startAngle, endAngle, segments, color);
+}
+
+void Renderer::DrawRing(Vector2 center, float innerRadius, float outerRadius,
+                        float startAngle, float endAngle, int segments,
+                        Color color) {
+  float r = std::max(innerRadius, outerRadius);
+  DrawCommand cmd = MakeCommand(DrawCommandType::Ring,
+                                {center.x - r, center.y - r, 2.0f * r, 2.0f * r},
+                                color);
+  cmd.segments = (uint8_t)std::clamp(segments, 0, 255);
+  cmd.ring = {center, innerRadius, outerRadius, startAngle, endAngle};
+  DrawCommandBuffer::Submit(cmd);
+}
+
+void Renderer::DrawLine(Vector2 start, Vector2 end, float thickness,
+                        Color color) {
+  Vector2 points[2] = {start, end};
+  DrawCommand cmd = MakeCommand(DrawCommandType::Line,
+                                PointsBounds(points, 2, thickness / 2.0f),
+                                color);
+  cmd.line = {start, end, thickness};
+  DrawCommandBuffer::Submit(cmd);
+}
+
+void Renderer::DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) {
+  Vector2 points[3] = {v1, v2, v3};
+  DrawCommand cmd =
+      MakeCommand(DrawCommandType::Triangle, PointsBounds(points, 3, 0.0f),
+                  color);
+  cmd.triangle = {v1, v2, v3};
+  DrawCommandBuffer::Submit(cmd);
+}
+
+void Renderer::DrawTexture(Texture2D texture, Rectangle source, Rectangle dest,
+                           Color tint) {
+  if (texture.id == 0)
+    return;
+  uint32_t firstQuad = DrawCommandBuffer::QuadCount();
+  DrawCommandBuffer::AddQuad(source, dest);
+  DrawCommand cmd = MakeCommand(DrawCommandType::Quads, dest, tint);
+  cmd.textureId = texture.id;
+  cmd.quads = {firstQuad, 1, (float)texture.width, (float)texture.height};
+  DrawCommandBuffer::Submit(cmd);
+}
+
+void Renderer::DrawSdfTexture(Texture2D texture, Rectangle source,
+                              Rectangle dest, Color tint) {
+  if (texture.id == 0)
+    return;
+  uint32_t firstQuad = DrawCommandBuffer::QuadCount();
+  DrawCommandBuffer::AddQuad(source, dest);
+  DrawCommand cmd = MakeCommand(DrawCommandType::SdfQuads, dest, tint);
+  cmd.textureId = texture.id;
+  cmd.quads = {firstQuad, 1, (float)texture.width, (float)texture.height};
+  DrawCommandBuffer::Submit(cmd);
 }
 
 } // namespace raym3
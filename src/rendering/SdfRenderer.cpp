@@ -0,0 +1,305 @@
+#include "raym3/rendering/SdfRenderer.h"
+#include <algorithm>
+#include <cstddef>
+#include <raymath.h>
+#include <rlgl.h>
+
+namespace raym3 {
+
+// Vertex shader for GLSL 330 (desktop OpenGL 3.3)
+static const char *sdfVertShader330 = R"(#version 330
+in vec2 sdfPosition;
+in vec4 sdfShape;
+in vec3 sdfParams;
+in vec4 sdfColor;
+uniform mat4 mvp;
+out vec4 fragShape;
+out vec3 fragParams;
+out vec4 fragColor;
+void main() {
+    fragShape = sdfShape;
+    fragParams = sdfParams;
+    fragColor = sdfColor;
+    gl_Position = mvp * vec4(sdfPosition, 0.0, 1.0);
+}
+)";
+
+// Vertex shader for GLSL ES 300 (WebGL 2.0 / OpenGL ES 3.0)
+static const char *sdfVertShader300es = R"(#version 300 es
+in vec2 sdfPosition;
+in vec4 sdfShape;
+in vec3 sdfParams;
+in vec4 sdfColor;
+uniform mat4 mvp;
+out vec4 fragShape;
+out vec3 fragParams;
+out vec4 fragColor;
+void main() {
+    fragShape = sdfShape;
+    fragParams = sdfParams;
+    fragColor = sdfColor;
+    gl_Position = mvp * vec4(sdfPosition, 0.0, 1.0);
+}
+)";
+
+// fragShape.xy is the offset from the rectangle center, fragShape.zw its half
+// size. fragParams is (radius, lineWidth, softness).
+#define RAYM3_SDF_FRAGMENT_BODY                                                \
+  "float erfApprox(float x) {\n"                                               \
+  "    float s = sign(x), a = abs(x);\n"                                       \
+  "    x = 1.0 + (0.278393 + (0.230389 + 0.078108 * (a * a)) * a) * a;\n"      \
+  "    x *= x;\n"                                                              \
+  "    return s - s / (x * x);\n"                                              \
+  "}\n"                                                                        \
+  "void main() {\n"                                                            \
+  "    vec2 halfSize = fragShape.zw;\n"                                        \
+  "    float r = min(fragParams.x, min(halfSize.x, halfSize.y));\n"            \
+  "    vec2 q = abs(fragShape.xy) - halfSize + vec2(r);\n"                     \
+  "    float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - r;\n"         \
+  "    float coverage;\n"                                                      \
+  "    if (fragParams.z > 0.0) {\n"                                            \
+  "        coverage = 0.5 - 0.5 * erfApprox(d / (fragParams.z * 1.4142136));\n" \
+  "    } else {\n"                                                             \
+  "        float aa = max(fwidth(d), 0.0001);\n"                               \
+  "        coverage = clamp(0.5 - d / aa, 0.0, 1.0);\n"                        \
+  "        if (fragParams.y > 0.0) {\n"                                        \
+  "            float outer = clamp(0.5 - (d - fragParams.y) / aa, 0.0, 1.0);\n"  \
+  "            coverage = outer - coverage;\n"                                 \
+  "        }\n"                                                                \
+  "    }\n"                                                                    \
+  "    if (coverage <= 0.0) { discard; }\n"                                    \
+  "    finalColor = vec4(fragColor.rgb, fragColor.a * coverage);\n"            \
+  "}\n"
+
+// Fragment shader for GLSL 330 (desktop)
+static const char *sdfFragShader330 = "#version 330\n"
+                                      "in vec4 fragShape;\n"
+                                      "in vec3 fragParams;\n"
+                                      "in vec4 fragColor;\n"
+                                      "out vec4 finalColor;\n"
+                                      RAYM3_SDF_FRAGMENT_BODY;
+
+// Fragment shader for GLSL ES 300 (WebGL 2.0)
+static const char *sdfFragShader300es = "#version 300 es\n"
+                                        "precision highp float;\n"
+                                        "in vec4 fragShape;\n"
+                                        "in vec3 fragParams;\n"
+                                        "in vec4 fragColor;\n"
+                                        "out vec4 finalColor;\n"
+                                        RAYM3_SDF_FRAGMENT_BODY;
+
+#undef RAYM3_SDF_FRAGMENT_BODY
+
+// SDF text goes through rlgl's regular quad batch, so its shader uses raylib's
+// default attribute and uniform names. The texture's alpha is the distance
+// field with the glyph edge at 0.5; the gradient length converts it to screen
+// pixels so edges stay one pixel wide at any scale.
+#define RAYM3_SDF_TEXT_VERTEX_BODY                                             \
+  "in vec3 vertexPosition;\n"                                                  \
+  "in vec2 vertexTexCoord;\n"                                                  \
+  "in vec4 vertexColor;\n"                                                     \
+  "uniform mat4 mvp;\n"                                                        \
+  "out vec2 fragTexCoord;\n"                                                   \
+  "out vec4 fragColor;\n"                                                      \
+  "void main() {\n"                                                            \
+  "    fragTexCoord = vertexTexCoord;\n"                                       \
+  "    fragColor = vertexColor;\n"                                             \
+  "    gl_Position = mvp * vec4(vertexPosition, 1.0);\n"                       \
+  "}\n"
+
+#define RAYM3_SDF_TEXT_FRAGMENT_BODY                                           \
+  "in vec2 fragTexCoord;\n"                                                    \
+  "in vec4 fragColor;\n"                                                       \
+  "uniform sampler2D texture0;\n"                                              \
+  "uniform vec4 colDiffuse;\n"                                                 \
+  "out vec4 finalColor;\n"                                                     \
+  "void main() {\n"                                                            \
+  "    float d = texture(texture0, fragTexCoord).a - 0.5;\n"                   \
+  "    float aa = max(length(vec2(dFdx(d), dFdy(d))), 0.0001);\n"              \
+  "    float coverage = clamp(0.5 + d / aa, 0.0, 1.0);\n"                      \
+  "    if (coverage <= 0.0) { discard; }\n"                                    \
+  "    vec4 color = fragColor * colDiffuse;\n"                                 \
+  "    finalColor = vec4(color.rgb, color.a * coverage);\n"                    \
+  "}\n"
+
+static const char *sdfTextVertShader330 = "#version 330\n"
+                                          RAYM3_SDF_TEXT_VERTEX_BODY;
+static const char *sdfTextFragShader330 = "#version 330\n"
+                                          RAYM3_SDF_TEXT_FRAGMENT_BODY;
+static const char *sdfTextVertShader300es = "#version 300 es\n"
+                                            RAYM3_SDF_TEXT_VERTEX_BODY;
+static const char *sdfTextFragShader300es = "#version 300 es\n"
+                                            "precision highp float;\n"
+                                            RAYM3_SDF_TEXT_FRAGMENT_BODY;
+
+#undef RAYM3_SDF_TEXT_VERTEX_BODY
+#undef RAYM3_SDF_TEXT_FRAGMENT_BODY
+
+bool SdfRenderer::loaded_ = false;
+bool SdfRenderer::supported_ = false;
+Shader SdfRenderer::shader_ = {0};
+Shader SdfRenderer::textShader_ = {0};
+int SdfRenderer::locMvp_ = -1;
+int SdfRenderer::locPosition_ = -1;
+int SdfRenderer::locShape_ = -1;
+int SdfRenderer::locParams_ = -1;
+int SdfRenderer::locColor_ = -1;
+unsigned int SdfRenderer::vao_ = 0;
+unsigned int SdfRenderer::vbo_ = 0;
+int SdfRenderer::capacity_ = 0;
+std::vector<SdfRenderer::Vertex> SdfRenderer::vertices_;
+
+bool SdfRenderer::IsSupported() {
+  if (!loaded_)
+    Load();
+  return supported_;
+}
+
+bool SdfRenderer::IsTextSupported() {
+  if (!loaded_)
+    Load();
+  return textShader_.id != 0;
+}
+
+void SdfRenderer::Load() {
+  loaded_ = true;
+
+  // GLSL 100 has no fwidth() without an extension and no guaranteed vertex
+  // array objects, so those contexts keep the tessellated path.
+  int version = rlGetVersion();
+  if (version == RL_OPENGL_ES_30) {
+    shader_ = LoadShaderFromMemory(sdfVertShader300es, sdfFragShader300es);
+    textShader_ =
+        LoadShaderFromMemory(sdfTextVertShader300es, sdfTextFragShader300es);
+  } else if (version == RL_OPENGL_33 || version == RL_OPENGL_43) {
+    shader_ = LoadShaderFromMemory(sdfVertShader330, sdfFragShader330);
+    textShader_ =
+        LoadShaderFromMemory(sdfTextVertShader330, sdfTextFragShader330);
+  } else {
+    return;
+  }
+
+  if (textShader_.id == rlGetShaderIdDefault())
+    textShader_ = {0};
+
+  if (shader_.id == 0 || shader_.id == rlGetShaderIdDefault()) {
+    shader_ = {0};
+    return;
+  }
+
+  locMvp_ = rlGetLocationUniform(shader_.id, "mvp");
+  locPosition_ = rlGetLocationAttrib(shader_.id, "sdfPosition");
+  locShape_ = rlGetLocationAttrib(shader_.id, "sdfShape");
+  locParams_ = rlGetLocationAttrib(shader_.id, "sdfParams");
+  locColor_ = rlGetLocationAttrib(shader_.id, "sdfColor");
+  if (locMvp_ < 0 || locPosition_ < 0 || locShape_ < 0 || locParams_ < 0 ||
+      locColor_ < 0) {
+    UnloadShader(shader_);
+    shader_ = {0};
+    return;
+  }
+
+  supported_ = true;
+}
+
+void SdfRenderer::Shutdown() {
+  if (vbo_ != 0)
+    rlUnloadVertexBuffer(vbo_);
+  if (vao_ != 0)
+    rlUnloadVertexArray(vao_);
+  if (shader_.id != 0)
+    UnloadShader(shader_);
+  if (textShader_.id != 0)
+    UnloadShader(textShader_);
+  vao_ = 0;
+  vbo_ = 0;
+  capacity_ = 0;
+  shader_ = {0};
+  textShader_ = {0};
+  loaded_ = false;
+  supported_ = false;
+  vertices_.clear();
+  vertices_.shrink_to_fit();
+}
+
+void SdfRenderer::Add(const SdfShape &shape) {
+  // Cover the anti-aliasing fringe, the outside stroke and ~3 sigma of blur.
+  float margin = 1.0f + shape.lineWidth + 3.0f * shape.softness;
+  float halfWidth = shape.rec.width * 0.5f;
+  float halfHeight = shape.rec.height * 0.5f;
+  float cx = shape.rec.x + halfWidth;
+  float cy = shape.rec.y + halfHeight;
+  float ex = halfWidth + margin;
+  float ey = halfHeight + margin;
+
+  auto vertex = [&](float lx, float ly) {
+    return Vertex{cx + lx,       cy + ly,         lx,
+                  ly,            halfWidth,       halfHeight,
+                  shape.radius,  shape.lineWidth, shape.softness,
+                  shape.color.r, shape.color.g,   shape.color.b,
+                  shape.color.a};
+  };
+  Vertex tl = vertex(-ex, -ey);
+  Vertex bl = vertex(-ex, ey);
+  Vertex br = vertex(ex, ey);
+  Vertex tr = vertex(ex, -ey);
+  vertices_.insert(vertices_.end(), {tl, bl, br, tl, br, tr});
+}
+
+void SdfRenderer::EnsureCapacity(int vertexCount) {
+  if (vertexCount <= capacity_)
+    return;
+
+  if (vbo_ != 0)
+    rlUnloadVertexBuffer(vbo_);
+  if (vao_ != 0)
+    rlUnloadVertexArray(vao_);
+
+  capacity_ = std::max(capacity_ * 2, std::max(vertexCount, 6 * 256));
+  vao_ = rlLoadVertexArray();
+  rlEnableVertexArray(vao_);
+  vbo_ = rlLoadVertexBuffer(nullptr, capacity_ * (int)sizeof(Vertex), true);
+
+  const int stride = (int)sizeof(Vertex);
+  rlSetVertexAttribute(locPosition_, 2, RL_FLOAT, false, stride,
+                       (int)offsetof(Vertex, x));
+  rlEnableVertexAttribute(locPosition_);
+  rlSetVertexAttribute(locShape_, 4, RL_FLOAT, false, stride,
+                       (int)offsetof(Vertex, localX));
+  rlEnableVertexAttribute(locShape_);
+  rlSetVertexAttribute(locParams_, 3, RL_FLOAT, false, stride,
+                       (int)offsetof(Vertex, radius));
+  rlEnableVertexAttribute(locParams_);
+  rlSetVertexAttribute(locColor_, 4, RL_UNSIGNED_BYTE, true, stride,
+                       (int)offsetof(Vertex, r));
+  rlEnableVertexAttribute(locColor_);
+  rlDisableVertexArray();
+}
+
+void SdfRenderer::Draw() {
+  if (vertices_.empty())
+    return;
+  if (!IsSupported()) {
+    vertices_.clear();
+    return;
+  }
+
+  // Anything already queued in rlgl's batch was painted first.
+  rlDrawRenderBatchActive();
+
+  int count = (int)vertices_.size();
+  EnsureCapacity(count);
+
+  rlEnableShader(shader_.id);
+  rlSetUniformMatrix(locMvp_, MatrixMultiply(rlGetMatrixModelview(),
+                                             rlGetMatrixProjection()));
+  rlEnableVertexArray(vao_);
+  rlUpdateVertexBuffer(vbo_, vertices_.data(), count * (int)sizeof(Vertex), 0);
+  rlDrawVertexArray(0, count);
+  rlDisableVertexArray();
+  rlDisableShader();
+
+  vertices_.clear();
+}
+
+} // namespace raym3
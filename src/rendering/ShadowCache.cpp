@@ -0,0 +1,265 @@
+#include "raym3/rendering/ShadowCache.h"
+#include "raym3/rendering/DrawCommandBuffer.h"
+#include "raym3/rendering/PerfCounters.h"
+#include "raym3/rendering/RenderBackend.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                     \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RAYM3_SHADOW_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RAYM3_SHADOW_NEON 1
+#endif
+
+namespace raym3 {
+
+bool ShadowCache::enabled_ = true;
+int ShadowCache::capacity_ = 32;
+uint64_t ShadowCache::tick_ = 0;
+std::unordered_map<uint32_t, ShadowCache::Entry> ShadowCache::entries_;
+std::vector<Texture2D> ShadowCache::evicted_;
+ShadowCacheStats ShadowCache::stats_;
+
+// dst[i] += src[i] * weight. Both blur passes are expressed as a sum of
+// shifted rows, so this is the whole inner loop.
+static void AccumulateScaled(float *dst, const float *src, float weight,
+                             int count) {
+  int i = 0;
+#if defined(RAYM3_SHADOW_SSE2)
+  __m128 w = _mm_set1_ps(weight);
+  for (; i + 4 <= count; i += 4) {
+    __m128 d = _mm_loadu_ps(dst + i);
+    __m128 s = _mm_loadu_ps(src + i);
+    _mm_storeu_ps(dst + i, _mm_add_ps(d, _mm_mul_ps(s, w)));
+  }
+#elif defined(RAYM3_SHADOW_NEON)
+  float32x4_t w = vdupq_n_f32(weight);
+  for (; i + 4 <= count; i += 4) {
+    float32x4_t d = vld1q_f32(dst + i);
+    float32x4_t s = vld1q_f32(src + i);
+    vst1q_f32(dst + i, vmlaq_f32(d, s, w));
+  }
+#endif
+  for (; i < count; i++) {
+    dst[i] += src[i] * weight;
+  }
+}
+
+// Separable Gaussian blur of a size x size image. The source must be zero in
+// a band of `radius` texels around the shape.
+static void GaussianBlur(std::vector<float> &pixels, int size, float sigma,
+                         int radius) {
+  int taps = 2 * radius + 1;
+  std::vector<float> kernel(taps);
+  float sum = 0.0f;
+  for (int k = 0; k < taps; k++) {
+    float x = (float)(k - radius);
+    kernel[k] = std::exp(-(x * x) / (2.0f * sigma * sigma));
+    sum += kernel[k];
+  }
+  for (float &w : kernel)
+    w /= sum;
+
+  // Horizontal: rows padded with zeros on both sides so tap k of output x
+  // reads padded[x + k].
+  int paddedWidth = size + 2 * radius;
+  std::vector<float> padded((size_t)paddedWidth, 0.0f);
+  // Vertical input: `radius` zero rows above and below the image.
+  std::vector<float> rows((size_t)(size + 2 * radius) * size, 0.0f);
+  for (int y = 0; y < size; y++) {
+    std::copy_n(&pixels[(size_t)y * size], size, &padded[radius]);
+    float *out = &rows[(size_t)(y + radius) * size];
+    for (int k = 0; k < taps; k++)
+      AccumulateScaled(out, &padded[k], kernel[k], size);
+  }
+
+  std::fill(pixels.begin(), pixels.end(), 0.0f);
+  for (int y = 0; y < size; y++) {
+    float *out = &pixels[(size_t)y * size];
+    for (int k = 0; k < taps; k++)
+      AccumulateScaled(out, &rows[(size_t)(y + k) * size], kernel[k], size);
+  }
+}
+
+void ShadowCache::SetCapacity(int maxEntries) {
+  capacity_ = std::max(maxEntries, 1);
+  while ((int)entries_.size() > capacity_)
+    EvictOldest();
+}
+
+ShadowCache::Entry ShadowCache::Bake(int radius, float softness) {
+  // Texture layout along each axis: blur padding, the shape's corner, then a
+  // straight run long enough that the center texel sees no corner falloff.
+  int padding = (int)std::ceil(3.0f * softness);
+  int corner = radius + 2 * padding;
+  int size = 2 * corner + 1;
+
+  // Rounded rectangle mask inset by the padding, anti-aliased by distance.
+  std::vector<float> pixels((size_t)size * size, 0.0f);
+  float half = (size - 2 * padding) * 0.5f;
+  float center = size * 0.5f;
+  float r = std::min((float)radius, half);
+  for (int y = padding; y < size - padding; y++) {
+    for (int x = padding; x < size - padding; x++) {
+      float qx = std::abs(x + 0.5f - center) - half + r;
+      float qy = std::abs(y + 0.5f - center) - half + r;
+      float ox = std::max(qx, 0.0f), oy = std::max(qy, 0.0f);
+      float d = std::sqrt(ox * ox + oy * oy) + std::min(std::max(qx, qy), 0.0f) -
+                r;
+      pixels[(size_t)y * size + x] = std::clamp(0.5f - d, 0.0f, 1.0f);
+    }
+  }
+
+  if (padding > 0)
+    GaussianBlur(pixels, size, softness, padding);
+
+  // White with the blurred coverage as alpha; the draw tints it.
+  unsigned char *data = (unsigned char *)malloc((size_t)size * size * 2);
+  for (size_t i = 0; i < (size_t)size * size; i++) {
+    data[i * 2] = 255;
+    data[i * 2 + 1] =
+        (unsigned char)(std::clamp(pixels[i], 0.0f, 1.0f) * 255.0f + 0.5f);
+  }
+  Image image = {.data = data,
+                 .width = size,
+                 .height = size,
+                 .mipmaps = 1,
+                 .format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA};
+  RenderBackend *backend = RenderBackend::Get();
+  Texture2D texture = backend->LoadTexture(image);
+  UnloadImage(image); // Frees data
+  if (texture.id != 0)
+    backend->SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
+
+  return {texture, corner, padding, 0};
+}
+
+ShadowCache::Entry *ShadowCache::Acquire(int elevation, int radius,
+                                         float softness) {
+  uint32_t key = ((uint32_t)elevation << 16) | (uint32_t)radius;
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    stats_.hits++;
+    PerfCounters::Frame().shadowCacheHits++;
+    it->second.lastUsed = ++tick_;
+    return &it->second;
+  }
+
+  stats_.misses++;
+  PerfCounters::Frame().shadowCacheMisses++;
+  Entry entry = Bake(radius, softness);
+  if (entry.texture.id == 0)
+    return nullptr;
+
+  while ((int)entries_.size() >= capacity_)
+    EvictOldest();
+  entry.lastUsed = ++tick_;
+  stats_.entries++;
+  stats_.bytes += entry.texture.width * entry.texture.height * 2;
+  return &entries_.emplace(key, entry).first->second;
+}
+
+void ShadowCache::EvictOldest() {
+  auto oldest = entries_.end();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (oldest == entries_.end() || it->second.lastUsed < oldest->second.lastUsed)
+      oldest = it;
+  }
+  if (oldest == entries_.end())
+    return;
+
+  const Texture2D &texture = oldest->second.texture;
+  stats_.evictions++;
+  stats_.entries--;
+  stats_.bytes -= texture.width * texture.height * 2;
+  evicted_.push_back(texture);
+  entries_.erase(oldest);
+}
+
+bool ShadowCache::DrawShadow(Rectangle bounds, float cornerRadius,
+                             int elevation, float softness, Color color) {
+  float maxRadius = std::min(bounds.width, bounds.height) * 0.5f;
+  int radius = (int)std::lround(std::clamp(cornerRadius, 0.0f, maxRadius));
+  Entry *entry = Acquire(elevation, std::min(radius, 0xFFFF), softness);
+  if (!entry)
+    return false;
+
+  const Texture2D &texture = entry->texture;
+  float size = (float)texture.width;
+  float pad = (float)entry->padding;
+  Rectangle dest = {bounds.x - pad, bounds.y - pad, bounds.width + 2.0f * pad,
+                    bounds.height + 2.0f * pad};
+
+  // Corners keep their texel size; on very small shapes they are cropped.
+  float cw = std::min((float)entry->corner, dest.width * 0.5f);
+  float ch = std::min((float)entry->corner, dest.height * 0.5f);
+  float mid = (float)entry->corner; // The single stretchable texel
+  float innerW = dest.width - 2.0f * cw;
+  float innerH = dest.height - 2.0f * ch;
+  float right = dest.x + dest.width - cw;
+  float bottom = dest.y + dest.height - ch;
+
+  uint32_t firstQuad = DrawCommandBuffer::QuadCount();
+  DrawCommandBuffer::AddQuad({0, 0, cw, ch}, {dest.x, dest.y, cw, ch});
+  DrawCommandBuffer::AddQuad({size - cw, 0, cw, ch}, {right, dest.y, cw, ch});
+  DrawCommandBuffer::AddQuad({0, size - ch, cw, ch}, {dest.x, bottom, cw, ch});
+  DrawCommandBuffer::AddQuad({size - cw, size - ch, cw, ch},
+                             {right, bottom, cw, ch});
+  if (innerW > 0.0f) {
+    DrawCommandBuffer::AddQuad({mid, 0, 1, ch},
+                               {dest.x + cw, dest.y, innerW, ch});
+    DrawCommandBuffer::AddQuad({mid, size - ch, 1, ch},
+                               {dest.x + cw, bottom, innerW, ch});
+  }
+  if (innerH > 0.0f) {
+    DrawCommandBuffer::AddQuad({0, mid, cw, 1},
+                               {dest.x, dest.y + ch, cw, innerH});
+    DrawCommandBuffer::AddQuad({size - cw, mid, cw, 1},
+                               {right, dest.y + ch, cw, innerH});
+  }
+  if (innerW > 0.0f && innerH > 0.0f) {
+    DrawCommandBuffer::AddQuad({mid, mid, 1, 1},
+                               {dest.x + cw, dest.y + ch, innerW, innerH});
+  }
+
+  DrawCommand cmd = {};
+  cmd.type = DrawCommandType::Quads;
+  cmd.textureId = texture.id;
+  cmd.color = color;
+  cmd.bounds = dest;
+  cmd.quads = {firstQuad, DrawCommandBuffer::QuadCount() - firstQuad,
+               (float)texture.width, (float)texture.height};
+  DrawCommandBuffer::Submit(cmd);
+  return true;
+}
+
+void ShadowCache::EndFrame() {
+  for (const Texture2D &texture : evicted_)
+    RenderBackend::Get()->UnloadTexture(texture);
+  evicted_.clear();
+}
+
+void ShadowCache::Clear() {
+  for (auto &[key, entry] : entries_)
+    evicted_.push_back(entry.texture);
+  entries_.clear();
+  stats_.entries = 0;
+  stats_.bytes = 0;
+}
+
+void ShadowCache::Shutdown() {
+  Clear();
+  EndFrame();
+}
+
+void ShadowCache::ResetStats() {
+  stats_.hits = 0;
+  stats_.misses = 0;
+  stats_.evictions = 0;
+}
+
+} // namespace raym3
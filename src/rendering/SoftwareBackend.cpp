@@ -0,0 +1,531 @@
+#include "raym3/rendering/SoftwareBackend.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                     \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RAYM3_SOFTWARE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RAYM3_SOFTWARE_NEON 1
+#endif
+
+namespace raym3 {
+
+static inline int Div255(int x) {
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+static inline float Saturate(float v) { return std::clamp(v, 0.0f, 1.0f); }
+
+// Source-over blend of a single color into dst, weighting pixel i by
+// color.a * coverage[i]. Pixels are processed four at a time in 16-bit lanes.
+static void BlendSpan(Color *dst, const unsigned char *coverage, int count,
+                      Color color) {
+  int i = 0;
+#if defined(RAYM3_SOFTWARE_SSE2) || defined(RAYM3_SOFTWARE_NEON)
+  for (; i + 4 <= count; i += 4) {
+    uint16_t w[4];
+    int total = 0;
+    for (int k = 0; k < 4; k++) {
+      w[k] = (uint16_t)Div255(color.a * coverage[i + k]);
+      total += w[k];
+    }
+    if (total == 0)
+      continue;
+    if (total == 4 * 255) {
+      std::fill_n(dst + i, 4, Color{color.r, color.g, color.b, 255});
+      continue;
+    }
+#if defined(RAYM3_SOFTWARE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i k255 = _mm_set1_epi16(255);
+    const __m128i k128 = _mm_set1_epi16(128);
+    const __m128i src = _mm_set_epi16(255, color.b, color.g, color.r, 255,
+                                      color.b, color.g, color.r);
+    __m128i px = _mm_loadu_si128((const __m128i *)(dst + i));
+    __m128i halves[2] = {_mm_unpacklo_epi8(px, zero),
+                         _mm_unpackhi_epi8(px, zero)};
+    for (int h = 0; h < 2; h++) {
+      uint16_t a = w[h * 2], b = w[h * 2 + 1];
+      __m128i weight = _mm_set_epi16(b, b, b, b, a, a, a, a);
+      __m128i x = _mm_add_epi16(
+          _mm_mullo_epi16(halves[h], _mm_sub_epi16(k255, weight)),
+          _mm_mullo_epi16(src, weight));
+      x = _mm_add_epi16(x, k128);
+      halves[h] = _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+    _mm_storeu_si128((__m128i *)(dst + i),
+                     _mm_packus_epi16(halves[0], halves[1]));
+#else
+    const uint16x8_t k255 = vdupq_n_u16(255);
+    const uint16x8_t k128 = vdupq_n_u16(128);
+    const uint16_t srcLanes[8] = {color.r, color.g, color.b, 255,
+                                  color.r, color.g, color.b, 255};
+    const uint16x8_t src = vld1q_u16(srcLanes);
+    uint8x16_t px = vld1q_u8((const uint8_t *)(dst + i));
+    uint16x8_t halves[2] = {vmovl_u8(vget_low_u8(px)),
+                            vmovl_u8(vget_high_u8(px))};
+    for (int h = 0; h < 2; h++) {
+      uint16_t a = w[h * 2], b = w[h * 2 + 1];
+      const uint16_t lanes[8] = {a, a, a, a, b, b, b, b};
+      uint16x8_t weight = vld1q_u16(lanes);
+      uint16x8_t x = vmlaq_u16(vmulq_u16(halves[h], vsubq_u16(k255, weight)),
+                               src, weight);
+      x = vaddq_u16(x, k128);
+      halves[h] = vshrq_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+    }
+    vst1q_u8((uint8_t *)(dst + i),
+             vcombine_u8(vmovn_u16(halves[0]), vmovn_u16(halves[1])));
+#endif
+  }
+#endif
+  for (; i < count; i++) {
+    int w = Div255(color.a * coverage[i]);
+    if (w == 0)
+      continue;
+    Color &d = dst[i];
+    d.r = (unsigned char)Div255(d.r * (255 - w) + color.r * w);
+    d.g = (unsigned char)Div255(d.g * (255 - w) + color.g * w);
+    d.b = (unsigned char)Div255(d.b * (255 - w) + color.b * w);
+    d.a = (unsigned char)Div255(d.a * (255 - w) + 255 * w);
+  }
+}
+
+SoftwareBackend::SoftwareBackend(int width, int height) {
+  Resize(width, height);
+}
+
+void SoftwareBackend::Resize(int width, int height) {
+  width_ = std::max(width, 0);
+  height_ = std::max(height, 0);
+  pixels_.assign((size_t)width_ * height_, Color{0, 0, 0, 0});
+  retainedValid_ = false;
+  SetScissor(nullptr);
+}
+
+void SoftwareBackend::Clear(Color color) {
+  std::fill(pixels_.begin(), pixels_.end(), color);
+  retainedValid_ = false;
+}
+
+Image SoftwareBackend::GetImage() const {
+  return {.data = (void *)pixels_.data(),
+          .width = width_,
+          .height = height_,
+          .mipmaps = 1,
+          .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+}
+
+bool SoftwareBackend::Export(const char *path) const {
+  return ExportImage(GetImage(), path);
+}
+
+Texture2D SoftwareBackend::LoadTexture(const Image &image) {
+  if (!image.data || image.width <= 0 || image.height <= 0)
+    return {0};
+
+  Image rgba = ImageCopy(image);
+  ImageFormat(&rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  if (!rgba.data)
+    return {0};
+
+  SoftTexture texture = {rgba.width, rgba.height, image.format, {}};
+  texture.pixels.resize((size_t)rgba.width * rgba.height);
+  memcpy(texture.pixels.data(), rgba.data,
+         texture.pixels.size() * sizeof(Color));
+  UnloadImage(rgba);
+
+  unsigned int id = nextTextureId_++;
+  textures_[id] = std::move(texture);
+  return {id, image.width, image.height, 1, image.format};
+}
+
+void SoftwareBackend::UnloadTexture(Texture2D texture) {
+  textures_.erase(texture.id);
+}
+
+void SoftwareBackend::UpdateTexture(Texture2D texture, Rectangle region,
+                                    const void *pixels) {
+  auto it = textures_.find(texture.id);
+  if (it == textures_.end() || !pixels)
+    return;
+  SoftTexture &target = it->second;
+  int x = (int)region.x, y = (int)region.y;
+  int w = (int)region.width, h = (int)region.height;
+  if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > target.width ||
+      y + h > target.height)
+    return;
+
+  Image source = {.data = (void *)pixels,
+                  .width = w,
+                  .height = h,
+                  .mipmaps = 1,
+                  .format = target.format};
+  Image rgba = ImageCopy(source);
+  ImageFormat(&rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  if (!rgba.data)
+    return;
+  const Color *src = (const Color *)rgba.data;
+  for (int row = 0; row < h; row++) {
+    memcpy(&target.pixels[(size_t)(y + row) * target.width + x],
+           src + (size_t)row * w, (size_t)w * sizeof(Color));
+  }
+  UnloadImage(rgba);
+}
+
+void SoftwareBackend::SetScissor(const Rectangle *bounds) {
+  clipX0_ = 0;
+  clipY0_ = 0;
+  clipX1_ = width_;
+  clipY1_ = height_;
+  if (!bounds)
+    return;
+  // Integer truncation, like BeginScissorMode().
+  int x = (int)bounds->x, y = (int)bounds->y;
+  clipX0_ = std::clamp(x, 0, width_);
+  clipY0_ = std::clamp(y, 0, height_);
+  clipX1_ = std::clamp(x + (int)bounds->width, clipX0_, width_);
+  clipY1_ = std::clamp(y + (int)bounds->height, clipY0_, height_);
+}
+
+bool SoftwareBackend::BeginRetained() {
+  bool intact = retainedValid_;
+  retainedValid_ = true;
+  return intact;
+}
+
+void SoftwareBackend::ClearRegion(Rectangle region, Color color) {
+  int x0 = std::clamp((int)region.x, 0, width_);
+  int y0 = std::clamp((int)region.y, 0, height_);
+  int x1 = std::clamp((int)(region.x + region.width), x0, width_);
+  int y1 = std::clamp((int)(region.y + region.height), y0, height_);
+  for (int y = y0; y < y1; y++) {
+    Color *row = &pixels_[(size_t)y * width_];
+    std::fill(row + x0, row + x1, color);
+  }
+}
+
+template <typename CoverageFn>
+void SoftwareBackend::FillShape(Rectangle bounds, Color color,
+                                CoverageFn coverage) {
+  if (color.a == 0)
+    return;
+  int x0 = std::max(clipX0_, (int)std::floor(bounds.x));
+  int y0 = std::max(clipY0_, (int)std::floor(bounds.y));
+  int x1 = std::min(clipX1_, (int)std::ceil(bounds.x + bounds.width));
+  int y1 = std::min(clipY1_, (int)std::ceil(bounds.y + bounds.height));
+  if (x0 >= x1 || y0 >= y1)
+    return;
+
+  int count = x1 - x0;
+  coverage_.resize(count);
+  for (int y = y0; y < y1; y++) {
+    float py = (float)y + 0.5f;
+    for (int x = x0; x < x1; x++) {
+      float c = coverage((float)x + 0.5f, py);
+      coverage_[x - x0] = (unsigned char)(Saturate(c) * 255.0f + 0.5f);
+    }
+    BlendSpan(&pixels_[(size_t)y * width_ + x0], coverage_.data(), count,
+              color);
+  }
+}
+
+void SoftwareBackend::FillRectangle(Rectangle rec, Color color) {
+  float right = rec.x + rec.width;
+  float bottom = rec.y + rec.height;
+  // Box-filtered: coverage is the pixel's overlap with the rectangle.
+  FillShape(rec, color, [&](float px, float py) {
+    float cx = std::min(px + 0.5f, right) - std::max(px - 0.5f, rec.x);
+    float cy = std::min(py + 0.5f, bottom) - std::max(py - 0.5f, rec.y);
+    return Saturate(cx) * Saturate(cy);
+  });
+}
+
+void SoftwareBackend::FillRoundedRectangle(Rectangle rec, float radius,
+                                           float lineWidth, float softness,
+                                           Color color) {
+  float halfW = rec.width * 0.5f;
+  float halfH = rec.height * 0.5f;
+  float cx = rec.x + halfW;
+  float cy = rec.y + halfH;
+  float r = std::clamp(radius, 0.0f, std::min(halfW, halfH));
+  float pad = 1.0f + lineWidth + 3.0f * softness;
+  Rectangle bounds = {rec.x - pad, rec.y - pad, rec.width + 2.0f * pad,
+                      rec.height + 2.0f * pad};
+
+  // Same distance field and coverage rules as the SDF shader.
+  FillShape(bounds, color, [&](float px, float py) {
+    float qx = std::abs(px - cx) - halfW + r;
+    float qy = std::abs(py - cy) - halfH + r;
+    float ox = std::max(qx, 0.0f), oy = std::max(qy, 0.0f);
+    float d = std::sqrt(ox * ox + oy * oy) + std::min(std::max(qx, qy), 0.0f) -
+              r;
+    if (softness > 0.0f)
+      return 0.5f - 0.5f * std::erf(d / (softness * 1.4142136f));
+    float fill = Saturate(0.5f - d);
+    if (lineWidth > 0.0f)
+      return Saturate(0.5f - (d - lineWidth)) - fill;
+    return fill;
+  });
+}
+
+void SoftwareBackend::FillRing(const RingParams &ring, Color color) {
+  float inner = std::min(ring.innerRadius, ring.outerRadius);
+  float outer = std::max(ring.innerRadius, ring.outerRadius);
+  float start = std::min(ring.startAngle, ring.endAngle);
+  float span = std::abs(ring.endAngle - ring.startAngle);
+  bool full = span >= 360.0f;
+  Rectangle bounds = {ring.center.x - outer - 1.0f,
+                      ring.center.y - outer - 1.0f, 2.0f * outer + 2.0f,
+                      2.0f * outer + 2.0f};
+
+  FillShape(bounds, color, [&](float px, float py) {
+    float dx = px - ring.center.x;
+    float dy = py - ring.center.y;
+    float d = std::sqrt(dx * dx + dy * dy);
+    float c = Saturate(outer - d + 0.5f);
+    if (inner > 0.0f)
+      c *= Saturate(d - inner + 0.5f);
+    if (full || c == 0.0f)
+      return c;
+
+    // Angles grow clockwise on screen, as in raylib's DrawRing.
+    float angle = std::atan2(dy, dx) * RAD2DEG - start;
+    angle = std::fmod(angle, 360.0f);
+    if (angle < 0.0f)
+      angle += 360.0f;
+    float edge = angle <= span ? std::min(angle, span - angle)
+                               : -std::min(angle - span, 360.0f - angle);
+    return c * Saturate(0.5f + edge * DEG2RAD * d);
+  });
+}
+
+void SoftwareBackend::FillLine(const LineParams &line, Color color) {
+  float dx = line.end.x - line.start.x;
+  float dy = line.end.y - line.start.y;
+  float length = std::sqrt(dx * dx + dy * dy);
+  if (length <= 0.0f || line.thickness <= 0.0f)
+    return;
+  float ux = dx / length, uy = dy / length;
+  float half = line.thickness * 0.5f;
+  Rectangle bounds = {std::min(line.start.x, line.end.x) - half - 1.0f,
+                      std::min(line.start.y, line.end.y) - half - 1.0f,
+                      std::abs(dx) + line.thickness + 2.0f,
+                      std::abs(dy) + line.thickness + 2.0f};
+
+  // A thick segment without caps, like DrawLineEx.
+  FillShape(bounds, color, [&](float px, float py) {
+    float rx = px - line.start.x, ry = py - line.start.y;
+    float along = rx * ux + ry * uy;
+    float across = std::abs(rx * uy - ry * ux);
+    return Saturate(half - across + 0.5f) * Saturate(along + 0.5f) *
+           Saturate(length - along + 0.5f);
+  });
+}
+
+void SoftwareBackend::FillTriangle(const TriangleParams &triangle,
+                                   Color color) {
+  const Vector2 v[3] = {triangle.v1, triangle.v2, triangle.v3};
+  float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) -
+               (v[1].y - v[0].y) * (v[2].x - v[0].x);
+  // raylib culls triangles that are not counter-clockwise on screen.
+  if (area >= 0.0f)
+    return;
+
+  struct Edge {
+    float ox, oy, nx, ny;
+  } edges[3];
+  for (int i = 0; i < 3; i++) {
+    Vector2 a = v[i], b = v[(i + 1) % 3];
+    float ex = b.x - a.x, ey = b.y - a.y;
+    float len = std::sqrt(ex * ex + ey * ey);
+    if (len <= 0.0f)
+      return;
+    // Inward unit normal for a counter-clockwise (on screen) triangle.
+    edges[i] = {a.x, a.y, -ey / len, ex / len};
+  }
+
+  float minX = std::min({v[0].x, v[1].x, v[2].x});
+  float minY = std::min({v[0].y, v[1].y, v[2].y});
+  float maxX = std::max({v[0].x, v[1].x, v[2].x});
+  float maxY = std::max({v[0].y, v[1].y, v[2].y});
+  Rectangle bounds = {minX - 1.0f, minY - 1.0f, maxX - minX + 2.0f,
+                      maxY - minY + 2.0f};
+
+  FillShape(bounds, color, [&](float px, float py) {
+    float c = 1.0f;
+    for (const Edge &e : edges)
+      c *= Saturate(0.5f - ((px - e.ox) * e.nx + (py - e.oy) * e.ny));
+    return c;
+  });
+}
+
+void SoftwareBackend::DrawQuads(const DrawCommand &cmd,
+                                const TexturedQuad *quads) {
+  auto it = textures_.find(cmd.textureId);
+  if (it == textures_.end() || cmd.color.a == 0)
+    return;
+  const SoftTexture &texture = it->second;
+  const Color tint = cmd.color;
+
+  for (uint32_t q = 0; q < cmd.quads.quadCount; q++) {
+    const TexturedQuad &quad = quads[cmd.quads.firstQuad + q];
+    Rectangle d = quad.dest;
+    Rectangle s = quad.source;
+    if (d.width <= 0.0f || d.height <= 0.0f)
+      continue;
+
+    // Pixels whose centers fall inside the destination.
+    int x0 = std::max(clipX0_, (int)std::ceil(d.x - 0.5f));
+    int y0 = std::max(clipY0_, (int)std::ceil(d.y - 0.5f));
+    int x1 = std::min(clipX1_, (int)std::ceil(d.x + d.width - 0.5f));
+    int y1 = std::min(clipY1_, (int)std::ceil(d.y + d.height - 0.5f));
+    if (x0 >= x1 || y0 >= y1)
+      continue;
+
+    int minU = std::max(0, (int)std::floor(std::min(s.x, s.x + s.width)));
+    int maxU = std::min(texture.width - 1,
+                        (int)std::ceil(std::max(s.x, s.x + s.width)) - 1);
+    int minV = std::max(0, (int)std::floor(std::min(s.y, s.y + s.height)));
+    int maxV = std::min(texture.height - 1,
+                        (int)std::ceil(std::max(s.y, s.y + s.height)) - 1);
+    if (minU > maxU || minV > maxV)
+      continue;
+    float du = s.width / d.width;
+    float dv = s.height / d.height;
+
+    for (int y = y0; y < y1; y++) {
+      int tv = (int)std::floor(s.y + ((float)y + 0.5f - d.y) * dv);
+      const Color *row = &texture.pixels[(size_t)std::clamp(tv, minV, maxV) *
+                                         texture.width];
+      Color *out = &pixels_[(size_t)y * width_];
+      for (int x = x0; x < x1; x++) {
+        int tu = (int)std::floor(s.x + ((float)x + 0.5f - d.x) * du);
+        Color t = row[std::clamp(tu, minU, maxU)];
+        int w = Div255(t.a * tint.a);
+        if (w == 0)
+          continue;
+        Color &o = out[x];
+        o.r = (unsigned char)Div255(o.r * (255 - w) + Div255(t.r * tint.r) * w);
+        o.g = (unsigned char)Div255(o.g * (255 - w) + Div255(t.g * tint.g) * w);
+        o.b = (unsigned char)Div255(o.b * (255 - w) + Div255(t.b * tint.b) * w);
+        o.a = (unsigned char)Div255(o.a * (255 - w) + 255 * w);
+      }
+    }
+  }
+}
+
+// Distance fields are encoded like raylib's FONT_SDF glyphs: the edge is at
+// alpha 128 and alpha changes by 64 per texel.
+static constexpr float kSdfEdgeValue = 127.5f;
+static constexpr float kSdfValuePerTexel = 64.0f;
+
+void SoftwareBackend::DrawSdfQuads(const DrawCommand &cmd,
+                                   const TexturedQuad *quads) {
+  auto it = textures_.find(cmd.textureId);
+  if (it == textures_.end() || cmd.color.a == 0)
+    return;
+  const SoftTexture &texture = it->second;
+  auto alpha = [&](int u, int v) {
+    u = std::clamp(u, 0, texture.width - 1);
+    v = std::clamp(v, 0, texture.height - 1);
+    return (float)texture.pixels[(size_t)v * texture.width + u].a;
+  };
+
+  for (uint32_t q = 0; q < cmd.quads.quadCount; q++) {
+    const TexturedQuad &quad = quads[cmd.quads.firstQuad + q];
+    Rectangle d = quad.dest;
+    Rectangle s = quad.source;
+    if (d.width <= 0.0f || d.height <= 0.0f)
+      continue;
+
+    int x0 = std::max(clipX0_, (int)std::ceil(d.x - 0.5f));
+    int y0 = std::max(clipY0_, (int)std::ceil(d.y - 0.5f));
+    int x1 = std::min(clipX1_, (int)std::ceil(d.x + d.width - 0.5f));
+    int y1 = std::min(clipY1_, (int)std::ceil(d.y + d.height - 0.5f));
+    if (x0 >= x1 || y0 >= y1)
+      continue;
+
+    float du = s.width / d.width;
+    float dv = s.height / d.height;
+    // Field units per screen pixel; the edge ramp is one pixel wide.
+    float ramp = kSdfValuePerTexel *
+                 std::max(0.5f * (std::fabs(du) + std::fabs(dv)), 1e-3f);
+    int count = x1 - x0;
+    coverage_.resize(count);
+
+    for (int y = y0; y < y1; y++) {
+      float fv = s.y + ((float)y + 0.5f - d.y) * dv - 0.5f;
+      int v = (int)std::floor(fv);
+      float tv = fv - (float)v;
+      for (int x = x0; x < x1; x++) {
+        float fu = s.x + ((float)x + 0.5f - d.x) * du - 0.5f;
+        int u = (int)std::floor(fu);
+        float tu = fu - (float)u;
+        float top = alpha(u, v) + (alpha(u + 1, v) - alpha(u, v)) * tu;
+        float bottom =
+            alpha(u, v + 1) + (alpha(u + 1, v + 1) - alpha(u, v + 1)) * tu;
+        float field = top + (bottom - top) * tv;
+        float c = Saturate(0.5f + (field - kSdfEdgeValue) / ramp);
+        coverage_[x - x0] = (unsigned char)(c * 255.0f + 0.5f);
+      }
+      BlendSpan(&pixels_[(size_t)y * width_ + x0], coverage_.data(), count,
+                cmd.color);
+    }
+  }
+}
+
+void SoftwareBackend::Execute(const DrawCommand &cmd,
+                              const TexturedQuad *quads) {
+  switch (cmd.type) {
+  case DrawCommandType::Rectangle:
+    FillRectangle(cmd.rect.rec, cmd.color);
+    break;
+  case DrawCommandType::RectangleLines: {
+    // Stroked inside the rectangle, like DrawRectangleLinesEx.
+    Rectangle r = cmd.rect.rec;
+    float t = std::min(cmd.rect.lineWidth, std::min(r.width, r.height) * 0.5f);
+    FillRectangle({r.x, r.y, r.width, t}, cmd.color);
+    FillRectangle({r.x, r.y + r.height - t, r.width, t}, cmd.color);
+    FillRectangle({r.x, r.y + t, t, r.height - 2.0f * t}, cmd.color);
+    FillRectangle({r.x + r.width - t, r.y + t, t, r.height - 2.0f * t},
+                  cmd.color);
+    break;
+  }
+  case DrawCommandType::RoundedRectangle:
+  case DrawCommandType::RoundedRectangleLines: {
+    Rectangle r = cmd.rect.rec;
+    float radius = cmd.rect.roundness * std::min(r.width, r.height) * 0.5f;
+    float lineWidth = cmd.type == DrawCommandType::RoundedRectangleLines
+                          ? std::max(cmd.rect.lineWidth, 1.0f)
+                          : 0.0f;
+    FillRoundedRectangle(r, radius, lineWidth, 0.0f, cmd.color);
+    break;
+  }
+  case DrawCommandType::SdfRectangle:
+    FillRoundedRectangle(cmd.sdf.rec, cmd.sdf.radius, cmd.sdf.lineWidth,
+                         cmd.sdf.softness, cmd.color);
+    break;
+  case DrawCommandType::Ring:
+    FillRing(cmd.ring, cmd.color);
+    break;
+  case DrawCommandType::Line:
+    FillLine(cmd.line, cmd.color);
+    break;
+  case DrawCommandType::Triangle:
+    FillTriangle(cmd.triangle, cmd.color);
+    break;
+  case DrawCommandType::Quads:
+    DrawQuads(cmd, quads);
+    break;
+  case DrawCommandType::SdfQuads:
+    DrawSdfQuads(cmd, quads);
+    break;
+  }
+}
+
+} // namespace raym3
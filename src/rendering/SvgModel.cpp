@@ -31,6 +31,11 @@ bool SvgModel::LoadFromString(const char *data) {
   return image != nullptr;
 }
 
+void SvgModel::Adopt(NSVGimage *parsed) {
+  Unload();
+  image = parsed;
+}
+
 void SvgModel::Unload() {
   if (image) {
     nsvgDelete(image);
@@ -38,6 +43,19 @@ void SvgModel::Unload() {
   }
 }
 
+size_t SvgModel::GetMemoryUsage() const {
+  if (!image)
+    return 0;
+  size_t bytes = sizeof(NSVGimage);
+  for (NSVGshape *shape = image->shapes; shape != nullptr;
+       shape = shape->next) {
+    bytes += sizeof(NSVGshape);
+    for (NSVGpath *path = shape->paths; path != nullptr; path = path->next)
+      bytes += sizeof(NSVGpath) + (size_t)path->npts * 2 * sizeof(float);
+  }
+  return bytes;
+}
+
 void SvgModel::SetColor(unsigned int color) {
   if (!image)
     return;
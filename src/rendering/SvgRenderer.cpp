@@ -1,9 +1,19 @@
 #include "raym3/rendering/SvgRenderer.h"
+#include "raym3/rendering/IconAtlas.h"
+#include "raym3/rendering/IconPack.h"
+#include "raym3/rendering/PerfCounters.h"
+#include "raym3/rendering/PrewarmManifest.h"
+#include "raym3/rendering/RenderBackend.h"
+#include "raym3/rendering/Renderer.h"
 #include "raym3/rendering/SvgModel.h"
 #include "raym3/config.h"
 #ifndef __EMSCRIPTEN__
 #include <filesystem>
 #endif
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iterator>
 #include <iostream>
 #include <vector>
 #include <cstring>
@@ -15,10 +25,54 @@
 #define NANOSVGRAST_IMPLEMENTATION
 #include "external/nanosvgrast.h"
 
+#if defined(__SSE2__) || defined(_M_X64) ||                                     \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RAYM3_ICON_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RAYM3_ICON_NEON 1
+#endif
+
 namespace raym3 {
 
 std::string SvgRenderer::basePath = "";
-std::unordered_map<std::string, Texture2D> SvgRenderer::textureCache;
+std::vector<SvgRenderer::IconName> SvgRenderer::iconNames;
+SvgRenderer::NameMap SvgRenderer::iconIds[5];
+SvgRenderer::IconCache SvgRenderer::iconCache;
+uint64_t SvgRenderer::frameCount = 0;
+size_t SvgRenderer::iconBudget = 1024 * 1024;
+bool SvgRenderer::sizeBuckets = true;
+bool SvgRenderer::sdfEnabled = false;
+
+// Raster sizes. Each is at most 1/6 above the one before, so an icon is
+// never shrunk by more than that, which bilinear filtering does without
+// visible aliasing. The Material sizes (18, 20, 24, 36, 40, 48) are all
+// buckets, so icons at those sizes map texels 1:1.
+static constexpr int kSizeBuckets[] = {12, 14, 16, 18, 20, 22, 24, 28, 32, 36,
+                                       40, 44, 48, 56, 64, 72, 80, 88, 96};
+SvgIconCacheStats SvgRenderer::iconStats;
+LruCache<std::string, SvgRenderer::DocumentEntry, std::hash<std::string>,
+         SvgDocumentStats>
+    SvgRenderer::documents;
+size_t SvgRenderer::documentBudget = 1024 * 1024;
+std::mutex SvgRenderer::documentMutex;
+std::vector<NSVGrasterizer *> SvgRenderer::rasterizers;
+std::mutex SvgRenderer::rasterizerMutex;
+std::unordered_set<uint64_t> SvgRenderer::pendingIcons;
+bool SvgRenderer::asyncIcons = false;
+double SvgRenderer::uploadBudgetMs = 2.0;
+std::vector<std::thread> SvgRenderer::workers;
+uint64_t SvgRenderer::nextSequence = 0;
+uint64_t SvgRenderer::nextUpload = 0;
+std::map<uint64_t, SvgRenderer::IconResult> SvgRenderer::heldResults;
+std::mutex SvgRenderer::jobMutex;
+std::condition_variable SvgRenderer::jobReady;
+std::condition_variable SvgRenderer::jobsDone;
+std::deque<SvgRenderer::IconJob> SvgRenderer::jobs;
+std::vector<SvgRenderer::IconResult> SvgRenderer::finished;
+int SvgRenderer::jobsInFlight = 0;
+bool SvgRenderer::stopWorkers = false;
 bool SvgRenderer::autoDetected = false;
 
 static std::string DetectIconPath() {
@@ -58,17 +112,130 @@ void SvgRenderer::Initialize(const char *path) {
       basePath += '/';
     }
     autoDetected = false;
+    ClearMissing();
   } else if (!autoDetected) {
+    // With a pack, directories are only searched for icons it lacks.
+    if (!IconPack::IsOpen())
+      OpenDefaultPack();
+    if (!IconPack::IsOpen()) {
+      basePath = DetectIconPath();
+      autoDetected = true;
+    }
+    ClearMissing();
+  }
+}
+
+void SvgRenderer::OpenDefaultPack() {
+  const char *candidates[] = {RAYM3_ICON_PACK,
+                              RAYM3_RESOURCE_DIR "/icons.rm3i",
+                              "./resources/icons.rm3i", "./icons.rm3i"};
+  for (const char *candidate : candidates) {
+    if (IconPack::Open(candidate))
+      return;
+  }
+}
+
+bool SvgRenderer::LoadIconPack(const char *path) {
+  // Workers may be decoding from the current mapping.
+  {
+    std::unique_lock<std::mutex> lock(jobMutex);
+    jobsDone.wait(lock, [] { return jobsInFlight == 0; });
+  }
+  ClearMissing();
+  if (!path || !*path) {
+    IconPack::Close();
+    return true;
+  }
+  return IconPack::Open(path);
+}
+
+const std::string &SvgRenderer::GetBasePath(const char *name,
+                                            IconVariation variation) {
+  if (IconPack::Contains((int)variation, name))
+    return basePath;
+  if (basePath.empty() && !autoDetected) {
     basePath = DetectIconPath();
     autoDetected = true;
   }
+  return basePath;
 }
 
 void SvgRenderer::Shutdown() {
-  for (auto &pair : textureCache) {
-    UnloadTexture(pair.second);
+  StopWorkers();
+  IconPack::Close();
+  iconCache.clear();
+  iconStats = {};
+  iconNames.clear();
+  for (NameMap &ids : iconIds)
+    ids.clear();
+  IconAtlas::Shutdown();
+  ClearDocuments();
+  std::lock_guard<std::mutex> lock(rasterizerMutex);
+  for (NSVGrasterizer *rast : rasterizers)
+    nsvgDeleteRasterizer(rast);
+  rasterizers.clear();
+}
+
+static size_t IconBytes(const IconSlot &slot) {
+  return (size_t)slot.rect.width * (size_t)slot.rect.height * 2;
+}
+
+void SvgRenderer::ClearMissing() {
+  for (IconName &icon : iconNames)
+    icon.missing = false;
+}
+
+SvgRenderer::IconCache::iterator SvgRenderer::CacheIcon(uint64_t key,
+                                                        const IconSlot &slot) {
+  auto [it, inserted] =
+      iconCache.try_emplace(key, CachedIcon{slot, frameCount});
+  if (!inserted) {
+    // Replacing an icon frees its slot instead of leaking it.
+    IconAtlas::Free(it->second.slot);
+    iconStats.bytes -= IconBytes(it->second.slot);
+    it->second = {slot, frameCount};
+  } else {
+    iconStats.entries++;
+  }
+  iconStats.bytes += IconBytes(slot);
+  return it;
+}
+
+void SvgRenderer::EvictIcons() {
+  // Pages are unloaded only once empty, so scattered survivors can hold more
+  // pages than the icons need. Past a page of slack, everything not drawn
+  // this frame goes, letting the pages drain.
+  const size_t kPageBytes = 512 * 512 * 2;
+  bool compact = IconAtlas::GetStats().bytes > iconBudget + kPageBytes;
+  if (!compact && iconStats.bytes <= iconBudget)
+    return;
+
+  std::vector<IconCache::iterator> idle;
+  for (auto it = iconCache.begin(); it != iconCache.end(); ++it) {
+    if (it->second.lastUsed != frameCount)
+      idle.push_back(it);
+  }
+  // Least recently drawn first; ties by key so eviction is deterministic.
+  std::sort(idle.begin(), idle.end(), [](const auto &a, const auto &b) {
+    if (a->second.lastUsed != b->second.lastUsed)
+      return a->second.lastUsed < b->second.lastUsed;
+    return a->first < b->first;
+  });
+  for (auto it : idle) {
+    if (!compact && iconStats.bytes <= iconBudget)
+      break;
+    IconAtlas::Free(it->second.slot);
+    iconStats.bytes -= IconBytes(it->second.slot);
+    iconStats.entries--;
+    iconStats.evictions++;
+    iconCache.erase(it);
   }
-  textureCache.clear();
+}
+
+void SvgRenderer::EndFrame() {
+  EvictIcons();
+  IconAtlas::EndFrame();
+  frameCount++;
 }
 
 const char *SvgRenderer::GetVariationFolder(IconVariation variation) {
@@ -88,72 +255,171 @@ const char *SvgRenderer::GetVariationFolder(IconVariation variation) {
   }
 }
 
-std::string SvgRenderer::GetCacheKey(const char *name, IconVariation variation,
-                                     int width, int height) {
-  return std::string(name) + "_" + GetVariationFolder(variation) + "_" +
-         std::to_string(width) + "x" + std::to_string(height);
+#if RAYM3_EMBED_RESOURCES
+// The build groups embedded icons by variation and sorts each group by name,
+// so this is a binary search of one group comparing names in place.
+static const char *FindEmbeddedIcon(const char *name, IconVariation variation) {
+  const EmbeddedAssetRange &range = embedded_asset_ranges[(int)variation];
+  size_t prefix = strlen(SvgRenderer::GetVariationFolder(variation)) + 1;
+  int first = range.first;
+  int end = range.end;
+  while (first < end) {
+    int mid = first + (end - first) / 2;
+    int order = strcmp(embedded_assets[mid].path + prefix, name);
+    if (order == 0)
+      return embedded_assets[mid].content;
+    if (order < 0)
+      first = mid + 1;
+    else
+      end = mid;
+  }
+  return nullptr;
 }
+#endif
 
-Texture2D SvgRenderer::LoadSvgTexture(const char *name, IconVariation variation,
-                                      int width, int height) {
-  SvgModel model;
+std::shared_ptr<SvgModel> SvgRenderer::ParseDocument(const char *name,
+                                                     IconVariation variation,
+                                                     const std::string &base) {
+  auto model = std::make_shared<SvgModel>();
   bool loaded = false;
 
 #if RAYM3_EMBED_RESOURCES
-  std::string folder = GetVariationFolder(variation);
-  std::string iconKey = folder + "/" + name;
-  
-  // Linear search in static array (simpler/safer than static map init).
-  // Optimization: Could use binary search if sorted, or build map once lazily.
-  for (const auto* asset = embedded_assets; asset->path != nullptr; ++asset) {
-      if (iconKey == asset->path) {
-          loaded = model.LoadFromString(asset->content);
-          break;
-      }
-  }
+  if (const char *content = FindEmbeddedIcon(name, variation))
+    loaded = model->LoadFromString(content);
 #endif
+  if (!loaded && IconPack::IsOpen())
+    loaded = IconPack::Decode((int)variation, name, model.get());
 
   if (!loaded) {
 #ifdef __EMSCRIPTEN__
     // On WASM, icons should be embedded. If not found, log and return empty.
     std::string folder = GetVariationFolder(variation);
     std::cerr << "Icon not found in embedded resources: " << folder << "/" << name << std::endl;
-    return {0};
+    return nullptr;
 #else
-    if (basePath.empty() && !autoDetected) {
-      basePath = DetectIconPath();
-      autoDetected = true;
-    }
-
     std::string folder = GetVariationFolder(variation);
-    std::string fullPath = basePath + folder + "/" + name + ".svg";
+    std::string fullPath = base + folder + "/" + name + ".svg";
 
     if (!std::filesystem::exists(fullPath)) {
       std::cerr << "Icon not found: " << fullPath << std::endl;
-      return {0};
+      return nullptr;
     }
 
-    loaded = model.LoadFromFile(fullPath.c_str());
+    loaded = model->LoadFromFile(fullPath.c_str());
     if (!loaded) {
       std::cerr << "Failed to load SVG: " << fullPath << std::endl;
-      return {0};
+      return nullptr;
+    }
+#endif
+  }
+  return model;
+}
+
+std::shared_ptr<const SvgModel>
+SvgRenderer::GetDocument(const char *name, IconVariation variation,
+                         const std::string &base) {
+  std::string key = std::string(GetVariationFolder(variation)) + "/" + name;
+  std::unique_lock<std::mutex> lock(documentMutex);
+  if (const DocumentEntry *cached = documents.Find(key))
+    return cached->model;
+
+  // Workers parse different icons in parallel.
+  lock.unlock();
+  std::shared_ptr<SvgModel> model = ParseDocument(name, variation, base);
+  if (!model)
+    return nullptr;
+  size_t bytes = model->GetMemoryUsage();
+  lock.lock();
+  if (documents.Contains(key))
+    return model; // Parsed by another worker meanwhile
+  documents.Insert(key) = {model, bytes};
+  documents.GetStats().bytes += bytes;
+  // The newest document stays even if it alone exceeds the budget; callers
+  // holding an evicted one keep it alive through their shared_ptr.
+  EvictDocuments(1);
+  return model;
+}
+
+void SvgRenderer::EvictDocuments(size_t keep) {
+  SvgDocumentStats &stats = documents.GetStats();
+  while (stats.bytes > documentBudget && documents.Size() > keep) {
+    stats.bytes -= documents.Oldest().bytes;
+    documents.EvictOldest();
+  }
+}
+
+void SvgRenderer::SetDocumentBudget(size_t bytes) {
+  std::lock_guard<std::mutex> lock(documentMutex);
+  documentBudget = bytes;
+  EvictDocuments(0);
+}
+
+void SvgRenderer::ClearDocuments() {
+  std::lock_guard<std::mutex> lock(documentMutex);
+  documents.Clear();
+  documents.GetStats().bytes = 0;
+}
+
+NSVGrasterizer *SvgRenderer::AcquireRasterizer() {
+  {
+    std::lock_guard<std::mutex> lock(rasterizerMutex);
+    if (!rasterizers.empty()) {
+      NSVGrasterizer *rast = rasterizers.back();
+      rasterizers.pop_back();
+      return rast;
     }
+  }
+  return nsvgCreateRasterizer();
+}
+
+void SvgRenderer::ReleaseRasterizer(NSVGrasterizer *rast) {
+  std::lock_guard<std::mutex> lock(rasterizerMutex);
+  rasterizers.push_back(rast);
+}
+
+// Gray-alpha texels from nanosvg's RGBA: white, so the draw tint gives the
+// color, with the rasterized coverage as alpha.
+static void ExtractCoverage(const unsigned char *rgba, unsigned char *out,
+                            size_t count) {
+  size_t i = 0;
+#if defined(RAYM3_ICON_SSE2)
+  const __m128i white = _mm_set1_epi16(0x00ff);
+  for (; i + 8 <= count; i += 8) {
+    __m128i lo = _mm_loadu_si128((const __m128i *)(rgba + i * 4));
+    __m128i hi = _mm_loadu_si128((const __m128i *)(rgba + i * 4 + 16));
+    // Alpha to the low byte of each pixel, then pixels to 16-bit lanes.
+    __m128i alpha =
+        _mm_packs_epi32(_mm_srli_epi32(lo, 24), _mm_srli_epi32(hi, 24));
+    _mm_storeu_si128((__m128i *)(out + i * 2),
+                     _mm_or_si128(_mm_slli_epi16(alpha, 8), white));
+  }
+#elif defined(RAYM3_ICON_NEON)
+  for (; i + 8 <= count; i += 8) {
+    uint8x8x4_t pixels = vld4_u8(rgba + i * 4);
+    uint8x8x2_t grayAlpha = {{vdup_n_u8(255), pixels.val[3]}};
+    vst2_u8(out + i * 2, grayAlpha);
+  }
 #endif
+  for (; i < count; i++) {
+    out[i * 2] = 255;
+    out[i * 2 + 1] = rgba[i * 4 + 3];
   }
+}
 
+bool SvgRenderer::RasterizeIcon(const SvgModel &model, int width, int height,
+                                std::vector<unsigned char> *grayAlpha,
+                                int padding) {
   // Rasterize using nanosvgrast
-  NSVGrasterizer *rast = nsvgCreateRasterizer();
+  // Its edge and span buffers are kept between icons.
+  NSVGrasterizer *rast = AcquireRasterizer();
   if (rast == nullptr) {
-    return {0};
+    return false;
   }
 
-  // Allocate pixel buffer (RGBA)
-  int stride = width * 4;
-  unsigned char *data = (unsigned char *)MemAlloc(width * height * 4);
-  if (data == nullptr) {
-    nsvgDeleteRasterizer(rast);
-    return {0};
-  }
+  // nanosvgrast only writes RGBA; it clears the buffer itself.
+  int stride = width + 2 * padding;
+  size_t pixelCount = (size_t)stride * (height + 2 * padding);
+  std::vector<unsigned char> rgba(pixelCount * 4);
 
   // Scale SVG to fit width/height
   // NSVGimage has width/height.
@@ -164,68 +430,453 @@ Texture2D SvgRenderer::LoadSvgTexture(const char *name, IconVariation variation,
       (scaleX < scaleY) ? scaleX : scaleY; // Maintain aspect ratio? Or fill?
   // Icons are usually square.
 
-  nsvgRasterize(rast, image, 0, 0, scale, data, width, height, stride);
+  nsvgRasterize(rast, image, (float)padding, (float)padding, scale, rgba.data(),
+                stride, height + 2 * padding, stride * 4);
+  ReleaseRasterizer(rast);
+
+  grayAlpha->resize(pixelCount * 2);
+  ExtractCoverage(rgba.data(), grayAlpha->data(), pixelCount);
+  return true;
+}
 
-  // Post-process: Convert all pixels to White (preserving Alpha) so they can be
-  // tinted by Raylib
-  int pixelCount = width * height;
-  for (int i = 0; i < pixelCount; ++i) {
-    // data is RGBA
-    // We only care if there is some opacity.
-    // Actually, we can just set RGB to 255 regardless, relying on Alpha.
-    // But let's be safe and only touch non-transparent ones if needed.
-    // Raylib tinting multiplies: Final = Tex * Tint.
-    // If Tex is (0,0,0,A), Final is (0,0,0,A*TintA). Color is lost.
-    // If Tex is (255,255,255,A), Final is (TintR, TintG, TintB, A*TintA).
-    // Correct.
+// Distance fields are rasterized at kSdfIconSize, 2.7 texels per unit of a
+// 24-unit Material icon, with kSdfPadding texels of field around the shape.
+// They are encoded like raylib's FONT_SDF glyphs, which the SDF text shader
+// and SoftwareBackend draw: the edge is at alpha 127.5, rising by 64 per
+// texel inward, so the field saturates 2 texels from the edge.
+static constexpr int kSdfIconSize = 64;
+static constexpr int kSdfPadding = 4;
+static constexpr int kSdfTextureSize = kSdfIconSize + 2 * kSdfPadding;
+static constexpr float kSdfEdgeValue = 127.5f;
+static constexpr float kSdfValuePerTexel = 64.0f;
+static constexpr float kSdfFar = 1e20f;
+
+// Felzenszwalb and Huttenlocher's squared Euclidean distance transform along
+// one row or column of grid: count values, stride apart. f, z and v are
+// scratch of count, count + 1 and count entries.
+static void DistanceTransform(float *grid, int stride, int count, float *f,
+                              float *z, int *v) {
+  f[0] = grid[0];
+  v[0] = 0;
+  z[0] = -kSdfFar;
+  z[1] = kSdfFar;
+  // Lower envelope of the parabolas rooted at each sample.
+  for (int q = 1, k = 0; q < count; q++) {
+    f[q] = grid[q * stride];
+    float s;
+    do {
+      int r = v[k];
+      s = (f[q] - f[r] + (float)(q * q - r * r)) / (float)(2 * (q - r));
+    } while (s <= z[k] && --k > -1);
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = kSdfFar;
+  }
+  for (int q = 0, k = 0; q < count; q++) {
+    while (z[k + 1] < (float)q)
+      k++;
+    int r = v[k];
+    grid[q * stride] = f[r] + (float)((q - r) * (q - r));
+  }
+}
 
-    data[i * 4 + 0] = 255; // R
-    data[i * 4 + 1] = 255; // G
-    data[i * 4 + 2] = 255; // B
-                           // Alpha (data[i*4+3]) remains unchanged
+static void DistanceTransform2D(float *grid, int width, int height,
+                                std::vector<float> *f, std::vector<float> *z,
+                                std::vector<int> *v) {
+  for (int x = 0; x < width; x++)
+    DistanceTransform(grid + x, width, height, f->data(), z->data(),
+                      v->data());
+  for (int y = 0; y < height; y++)
+    DistanceTransform(grid + (size_t)y * width, 1, width, f->data(),
+                      z->data(), v->data());
+}
+
+// White gray-alpha texels from the squared distances to the shape outside
+// and inside each texel.
+static void EncodeDistance(const float *outside, const float *inside,
+                           unsigned char *out, size_t count) {
+  size_t i = 0;
+#if defined(RAYM3_ICON_SSE2)
+  const __m128 edge = _mm_set1_ps(kSdfEdgeValue);
+  const __m128 scale = _mm_set1_ps(kSdfValuePerTexel);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 full = _mm_set1_ps(255.0f);
+  const __m128i white = _mm_set1_epi16(0x00ff);
+  auto encode = [&](size_t at) {
+    __m128 d = _mm_sub_ps(_mm_sqrt_ps(_mm_loadu_ps(inside + at)),
+                          _mm_sqrt_ps(_mm_loadu_ps(outside + at)));
+    __m128 value = _mm_add_ps(edge, _mm_mul_ps(d, scale));
+    return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(value, zero), full));
+  };
+  for (; i + 8 <= count; i += 8) {
+    // Values are 0..255, so packing to 16-bit lanes cannot saturate.
+    __m128i alpha = _mm_packs_epi32(encode(i), encode(i + 4));
+    _mm_storeu_si128((__m128i *)(out + i * 2),
+                     _mm_or_si128(_mm_slli_epi16(alpha, 8), white));
+  }
+#elif defined(RAYM3_ICON_NEON) && defined(__aarch64__)
+  const float32x4_t edge = vdupq_n_f32(kSdfEdgeValue);
+  const float32x4_t zero = vdupq_n_f32(0.0f);
+  const float32x4_t full = vdupq_n_f32(255.0f);
+  auto encode = [&](size_t at) {
+    float32x4_t d = vsubq_f32(vsqrtq_f32(vld1q_f32(inside + at)),
+                              vsqrtq_f32(vld1q_f32(outside + at)));
+    float32x4_t value = vmlaq_n_f32(edge, d, kSdfValuePerTexel);
+    value = vminq_f32(vmaxq_f32(value, zero), full);
+    return vmovn_u32(vcvtnq_u32_f32(value));
+  };
+  for (; i + 8 <= count; i += 8) {
+    uint8x8_t alpha = vmovn_u16(vcombine_u16(encode(i), encode(i + 4)));
+    uint8x8x2_t grayAlpha = {{vdup_n_u8(255), alpha}};
+    vst2_u8(out + i * 2, grayAlpha);
   }
+#endif
+  for (; i < count; i++) {
+    float d = std::sqrt(inside[i]) - std::sqrt(outside[i]);
+    float value = std::clamp(kSdfEdgeValue + d * kSdfValuePerTexel, 0.0f,
+                             255.0f);
+    out[i * 2] = 255;
+    out[i * 2 + 1] = (unsigned char)std::lrint(value);
+  }
+}
 
-  // Create Raylib Image
-  Image rayImage = {.data = data,
-                    .width = width,
-                    .height = height,
-                    .mipmaps = 1,
-                    .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+bool SvgRenderer::RasterizeDistanceField(
+    const SvgModel &model, std::vector<unsigned char> *grayAlpha) {
+  if (!RasterizeIcon(model, kSdfIconSize, kSdfIconSize, grayAlpha,
+                     kSdfPadding))
+    return false;
+
+  // Seeded from the antialiased coverage, as in Mapbox's TinySDF: a partly
+  // covered texel is taken to be its uncovered fraction from the edge, which
+  // places the edge to a fraction of a texel.
+  const size_t count = (size_t)kSdfTextureSize * kSdfTextureSize;
+  std::vector<float> outside(count);
+  std::vector<float> inside(count);
+  for (size_t i = 0; i < count; i++) {
+    float coverage = (float)(*grayAlpha)[i * 2 + 1] / 255.0f;
+    if (coverage >= 1.0f) {
+      outside[i] = 0.0f;
+      inside[i] = kSdfFar;
+    } else if (coverage <= 0.0f) {
+      outside[i] = kSdfFar;
+      inside[i] = 0.0f;
+    } else {
+      float out = std::max(0.0f, 0.5f - coverage);
+      float in = std::max(0.0f, coverage - 0.5f);
+      outside[i] = out * out;
+      inside[i] = in * in;
+    }
+  }
 
-  Texture2D texture = LoadTextureFromImage(rayImage);
+  std::vector<float> f(kSdfTextureSize);
+  std::vector<float> z(kSdfTextureSize + 1);
+  std::vector<int> v(kSdfTextureSize);
+  DistanceTransform2D(outside.data(), kSdfTextureSize, kSdfTextureSize, &f,
+                      &z, &v);
+  DistanceTransform2D(inside.data(), kSdfTextureSize, kSdfTextureSize, &f,
+                      &z, &v);
+  EncodeDistance(outside.data(), inside.data(), grayAlpha->data(), count);
+  return true;
+}
 
-  // Cleanup
-  UnloadImage(rayImage); // Frees data
-  nsvgDeleteRasterizer(rast);
+bool SvgRenderer::LoadSvgIcon(IconHandle icon, int width, int height,
+                              bool sdf, IconSlot *slot) {
+  IconName &entry = iconNames[icon.id];
+  const char *name = entry.name.c_str();
+  std::shared_ptr<const SvgModel> model = GetDocument(
+      name, entry.variation, GetBasePath(name, entry.variation));
+  if (!model) {
+    entry.missing = true;
+    return false;
+  }
+  std::vector<unsigned char> grayAlpha;
+  if (sdf) {
+    return RasterizeDistanceField(*model, &grayAlpha) &&
+           IconAtlas::Add(grayAlpha.data(), kSdfTextureSize, kSdfTextureSize,
+                          slot);
+  }
+  return RasterizeIcon(*model, width, height, &grayAlpha) &&
+         IconAtlas::Add(grayAlpha.data(), width, height, slot);
+}
+
+void SvgRenderer::QueueIcon(uint64_t key, IconHandle icon, int width,
+                            int height, bool sdf) {
+#if RAYM3_ASYNC_ICONS
+  const IconName &entry = iconNames[icon.id];
+  const std::string &base = GetBasePath(entry.name.c_str(), entry.variation);
+  if (sdf)
+    width = height = kSdfTextureSize;
+  IconJob job = {nextSequence++, key,    icon.id, entry.name, entry.variation,
+                 width,          height, sdf,     base};
+  {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    jobs.push_back(std::move(job));
+    jobsInFlight++;
+  }
+  pendingIcons.insert(key);
+  if (workers.empty()) {
+    // Leave a core for the UI thread; parsing and rasterizing are short,
+    // so a few workers are plenty.
+    int count = (int)std::thread::hardware_concurrency() - 1;
+    count = std::clamp(count, 1, 4);
+    for (int i = 0; i < count; i++)
+      workers.emplace_back(WorkerLoop);
+  }
+  jobReady.notify_one();
+#else
+  (void)key, (void)icon, (void)width, (void)height, (void)sdf;
+#endif
+}
+
+void SvgRenderer::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(jobMutex);
+  while (true) {
+    jobReady.wait(lock, [] { return stopWorkers || !jobs.empty(); });
+    if (stopWorkers)
+      return;
+    IconJob job = std::move(jobs.front());
+    jobs.pop_front();
+
+    lock.unlock();
+    IconResult result = {job.sequence, job.key, job.icon, job.width,
+                         job.height,   {},      false};
+    std::shared_ptr<const SvgModel> model =
+        GetDocument(job.name.c_str(), job.variation, job.base);
+    if (model) {
+      result.found = true;
+      bool rasterized =
+          job.sdf ? RasterizeDistanceField(*model, &result.pixels)
+                  : RasterizeIcon(*model, job.width, job.height,
+                                  &result.pixels);
+      if (!rasterized)
+        result.pixels.clear();
+    }
+    lock.lock();
+    finished.push_back(std::move(result));
+    jobsInFlight--;
+    if (jobsInFlight == 0)
+      jobsDone.notify_all();
+  }
+}
 
-  SetTextureFilter(texture, TEXTURE_FILTER_BILINEAR);
-  return texture;
+void SvgRenderer::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    stopWorkers = true;
+  }
+  jobReady.notify_all();
+  for (std::thread &worker : workers)
+    worker.join();
+  workers.clear();
+
+  jobs.clear();
+  finished.clear();
+  jobsInFlight = 0;
+  stopWorkers = false;
+  pendingIcons.clear();
+  heldResults.clear();
+  nextUpload = nextSequence;
+}
+
+void SvgRenderer::UploadFinished(bool budgeted) {
+  {
+    std::lock_guard<std::mutex> lock(jobMutex);
+    for (IconResult &result : finished)
+      heldResults.emplace(result.sequence, std::move(result));
+    finished.clear();
+  }
+
+  // Workers finish in any order; upload only the run that continues the
+  // request order, so which icons make a frame's budget is deterministic.
+  // Icons landing in new pages are uploaded with the page.
+  IconAtlas::BeginBatch();
+  auto start = std::chrono::steady_clock::now();
+  for (int uploaded = 0; !heldResults.empty(); uploaded++) {
+    auto next = heldResults.begin();
+    if (next->first != nextUpload)
+      break;
+    // At least one icon per frame, so a tiny budget still makes progress.
+    if (budgeted && uploaded > 0 &&
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start)
+                .count() >= uploadBudgetMs)
+      break;
+    IconResult result = std::move(next->second);
+    heldResults.erase(next);
+    nextUpload++;
+    pendingIcons.erase(result.key);
+    // Already cached, e.g. drawn synchronously after async mode was
+    // turned off while the job ran.
+    if (iconCache.count(result.key))
+      continue;
+    if (!result.found) {
+      iconNames[result.icon].missing = true;
+      continue;
+    }
+    IconSlot slot;
+    if (result.pixels.empty() || !IconAtlas::Add(result.pixels.data(),
+                                                 result.width, result.height,
+                                                 &slot))
+      continue;
+    PerfCounters::Frame().iconRasterizations++;
+    CacheIcon(result.key, slot);
+  }
+  IconAtlas::EndBatch();
+}
+
+void SvgRenderer::BeginFrame() { UploadFinished(true); }
+
+void SvgRenderer::WaitForPendingIcons() {
+  {
+    std::unique_lock<std::mutex> lock(jobMutex);
+    jobsDone.wait(lock, [] { return jobsInFlight == 0; });
+  }
+  UploadFinished(false);
+}
+
+int SvgRenderer::GetPendingIcons() { return (int)pendingIcons.size(); }
+
+int SvgRenderer::GetRasterizingIcons() {
+  std::lock_guard<std::mutex> lock(jobMutex);
+  return jobsInFlight;
+}
+
+bool SvgRenderer::Prewarm(IconHandle icon, float width, float height) {
+  if (width <= 0.0f || height <= 0.0f || icon.id < 0 ||
+      icon.id >= (int)iconNames.size() || iconNames[icon.id].missing)
+    return false;
+  bool sdf = IsSdfEnabled();
+  int rasterW = sdf ? 0 : GetRasterSize(width);
+  int rasterH = sdf ? 0 : GetRasterSize(height);
+  if (rasterW > 0xffff || rasterH > 0xffff)
+    return false;
+  uint64_t key = IconKey(icon, rasterW, rasterH);
+  if (iconCache.count(key) || pendingIcons.count(key))
+    return false;
+#if RAYM3_ASYNC_ICONS
+  QueueIcon(key, icon, rasterW, rasterH, sdf);
+  return true;
+#else
+  IconSlot slot;
+  if (LoadSvgIcon(icon, rasterW, rasterH, sdf, &slot)) {
+    PerfCounters::Frame().iconRasterizations++;
+    CacheIcon(key, slot);
+  }
+  return false; // Done now, nothing queued
+#endif
+}
+
+void SvgRenderer::SetAsyncIcons(bool enabled) { asyncIcons = enabled; }
+
+bool SvgRenderer::IsSdfEnabled() {
+  return sdfEnabled && RenderBackend::Get()->SupportsSdfText();
+}
+
+bool SvgRenderer::IsAsyncIconsEnabled() {
+#if RAYM3_ASYNC_ICONS
+  return asyncIcons;
+#else
+  return false;
+#endif
+}
+
+IconHandle SvgRenderer::GetIconHandle(const char *name,
+                                      IconVariation variation) {
+  NameMap &ids = iconIds[(int)variation];
+  auto it = ids.find(std::string_view(name));
+  if (it != ids.end())
+    return {it->second};
+  int id = (int)iconNames.size();
+  iconNames.push_back({name, variation, false});
+  ids.emplace(name, id);
+  return {id};
 }
 
 void SvgRenderer::DrawIcon(const char *name, Rectangle bounds,
                            IconVariation variation, Color color) {
-  int width = (int)bounds.width;
-  int height = (int)bounds.height;
+  DrawIcon(GetIconHandle(name, variation), bounds, color);
+}
 
-  if (width <= 0 || height <= 0)
+int SvgRenderer::GetRasterSize(float size) {
+  // Below 1/100 px over a whole pixel is float noise from layout math.
+  int wanted = (int)ceilf(size - 0.01f);
+  if (!sizeBuckets || wanted < kSizeBuckets[0])
+    return std::max(wanted, 1);
+  for (int bucket : kSizeBuckets) {
+    if (bucket >= wanted)
+      return bucket;
+  }
+  // Past the table, steps of 1/8 rounded to 8 px keep the same ratio.
+  int bucket = kSizeBuckets[std::size(kSizeBuckets) - 1];
+  while (bucket < wanted)
+    bucket = (bucket + bucket / 8 + 7) / 8 * 8;
+  return bucket;
+}
+
+void SvgRenderer::DrawIcon(IconHandle icon, Rectangle bounds, Color color) {
+  if (bounds.width <= 0.0f || bounds.height <= 0.0f || icon.id < 0 ||
+      icon.id >= (int)iconNames.size())
+    return;
+  bool sdf = IsSdfEnabled();
+  int width = sdf ? 0 : GetRasterSize(bounds.width);
+  int height = sdf ? 0 : GetRasterSize(bounds.height);
+  if (width > 0xffff || height > 0xffff)
     return;
 
-  std::string key = GetCacheKey(name, variation, width, height);
+  uint64_t key = IconKey(icon, width, height);
+  if (PrewarmManifest::IsRecording()) {
+    const IconName &entry = iconNames[icon.id];
+    PrewarmManifest::RecordIcon(
+        icon.id, entry.name, entry.variation,
+        sdf ? GetRasterSize(bounds.width) : width,
+        sdf ? GetRasterSize(bounds.height) : height);
+  }
 
-  Texture2D texture;
-  auto it = textureCache.find(key);
-  if (it != textureCache.end()) {
-    texture = it->second;
+  auto it = iconCache.find(key);
+  if (it != iconCache.end()) {
+    PerfCounters::Frame().iconCacheHits++;
   } else {
-    texture = LoadSvgTexture(name, variation, width, height);
-    if (texture.id != 0) {
-      textureCache[key] = texture;
+    PerfCounters::Frame().iconCacheMisses++;
+    if (iconNames[icon.id].missing)
+      return;
+    // Nothing is drawn until the icon is uploaded at a BeginFrame(). A
+    // prewarmed icon is on the workers even in synchronous mode; it is not
+    // rasterized a second time here.
+    if (pendingIcons.count(key))
+      return;
+    if (IsAsyncIconsEnabled()) {
+      QueueIcon(key, icon, width, height, sdf);
+      return;
     }
+    IconSlot slot;
+    if (!LoadSvgIcon(icon, width, height, sdf, &slot))
+      return;
+    PerfCounters::Frame().iconRasterizations++;
+    it = CacheIcon(key, slot);
   }
-
-  if (texture.id != 0) {
-    DrawTexture(texture, (int)bounds.x, (int)bounds.y, color);
+  it->second.lastUsed = frameCount;
+
+  const IconSlot &slot = it->second.slot;
+  if (sdf) {
+    // The field's padding scales with the icon, around the exact bounds.
+    float padX = kSdfPadding * bounds.width / kSdfIconSize;
+    float padY = kSdfPadding * bounds.height / kSdfIconSize;
+    Renderer::DrawSdfTexture(IconAtlas::GetTexture(slot.page), slot.rect,
+                             {bounds.x - padX, bounds.y - padY,
+                              bounds.width + 2.0f * padX,
+                              bounds.height + 2.0f * padY},
+                             color);
+    return;
   }
+
+  // The raster is the bucket size; bilinear filtering scales it down to the
+  // exact requested size, by at most 1/6.
+  Renderer::DrawTexture(IconAtlas::GetTexture(slot.page), slot.rect,
+                        {(float)(int)bounds.x, (float)(int)bounds.y,
+                         sizeBuckets ? bounds.width : (float)width,
+                         sizeBuckets ? bounds.height : (float)height},
+                        color);
 }
 
 } // namespace raym3
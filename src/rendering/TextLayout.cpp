@@ -0,0 +1,240 @@
+#include "raym3/rendering/TextLayout.h"
+#include "raym3/fonts/FontManager.h"
+#include "raym3/rendering/Renderer.h"
+#include "raym3/rendering/TextMeasureCache.h"
+#include "raym3/styles/Theme.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+namespace raym3 {
+
+static constexpr const char *kEllipsis = "...";
+
+bool TextLayout::enabled_ = true;
+int TextLayout::capacity_ = 256;
+LruCache<TextLayout::Key, TextLayoutResult, TextLayout::KeyHash>
+    TextLayout::cache_;
+TextLayoutResult TextLayout::scratch_;
+
+std::size_t TextLayout::KeyHash::operator()(const Key &key) const {
+  uint64_t h = key.text;
+  HashCombine(h, key.font);
+  HashCombine(h, FloatBits(key.fontSize) << 32 | FloatBits(key.maxWidth));
+  HashCombine(h, FloatBits(key.lineHeight) << 32 | (uint32_t)key.maxLines);
+  HashCombine(h, (uint64_t)key.weight << 16 | (uint64_t)key.alignment << 8 |
+                     (uint64_t)key.ellipsis);
+  return (std::size_t)h;
+}
+
+// Unscaled advance, as in Renderer::MeasureTextEx.
+static float GlyphAdvance(const Font &font, int codepoint) {
+  int index = FontManager::GetGlyphIndex(font, codepoint);
+  const GlyphInfo &glyph = font.glyphs[index];
+  if (glyph.advanceX > 0)
+    return (float)glyph.advanceX;
+  return font.recs[index].width + (float)glyph.offsetX;
+}
+
+void TextLayout::Build(const char *text, const TextLayoutStyle &style,
+                       Font font, TextLayoutResult *layout) {
+  layout->lines.clear();
+  layout->size = {0, 0};
+  layout->fontSize = style.fontSize;
+  layout->weight = style.weight;
+  layout->lineHeight = style.lineHeight > 0.0f
+                           ? style.lineHeight
+                           : style.fontSize * 20.0f / 14.0f;
+  layout->truncated = false;
+  if (text[0] == '\0')
+    return;
+
+  // Per codepoint: its byte offset and the width of everything before it,
+  // so any line's width is a subtraction.
+  bool hasGlyphs = font.glyphs && font.baseSize > 0;
+  float scale = hasGlyphs ? style.fontSize / (float)font.baseSize : 0.0f;
+  std::vector<int> offsets;
+  std::vector<int> codepoints;
+  std::vector<float> prefix(1, 0.0f);
+  for (int i = 0; text[i] != '\0';) {
+    int byteCount = 0;
+    int codepoint = GetCodepointNext(&text[i], &byteCount);
+    offsets.push_back(i);
+    codepoints.push_back(codepoint);
+    float advance = hasGlyphs && codepoint != '\n'
+                        ? GlyphAdvance(font, codepoint) * scale
+                        : 0.0f;
+    prefix.push_back(prefix.back() + advance);
+    i += std::max(byteCount, 1);
+  }
+  int count = (int)codepoints.size();
+  offsets.push_back((int)strlen(text));
+  float ellipsisWidth =
+      hasGlyphs ? 3.0f * GlyphAdvance(font, '.') * scale : 0.0f;
+
+  auto addLine = [&](int first, int last, bool ellipsis) {
+    TextLayoutLine line;
+    line.text.assign(text + offsets[first], offsets[last] - offsets[first]);
+    line.width = prefix[last] - prefix[first];
+    if (ellipsis) {
+      line.text += kEllipsis;
+      line.width += ellipsisWidth;
+    }
+    line.x = 0.0f;
+    layout->size.x = std::max(layout->size.x, line.width);
+    layout->lines.push_back(std::move(line));
+  };
+
+  float maxWidth = style.maxWidth;
+  for (int start = 0;;) {
+    int paragraphEnd = start;
+    while (paragraphEnd < count && codepoints[paragraphEnd] != '\n')
+      paragraphEnd++;
+
+    int lineStart = start;
+    do {
+      int lineEnd = paragraphEnd;
+      int next = paragraphEnd;
+      if (maxWidth > 0.0f) {
+        // Take codepoints while they fit, at least one per line.
+        int end = lineStart;
+        int lastSpace = -1;
+        while (end < paragraphEnd &&
+               (end == lineStart ||
+                prefix[end + 1] - prefix[lineStart] <= maxWidth)) {
+          if (codepoints[end] == ' ' && end > lineStart)
+            lastSpace = end;
+          end++;
+        }
+        if (end < paragraphEnd) {
+          if (codepoints[end] == ' ')
+            lineEnd = end;
+          else if (lastSpace > lineStart)
+            lineEnd = lastSpace;
+          else
+            lineEnd = end; // One word wider than the line
+          next = lineEnd;
+          while (next < paragraphEnd && codepoints[next] == ' ')
+            next++;
+        }
+      }
+      while (lineEnd > lineStart && codepoints[lineEnd - 1] == ' ')
+        lineEnd--;
+
+      bool more = next < paragraphEnd || paragraphEnd < count;
+      if (style.maxLines > 0 &&
+          (int)layout->lines.size() == style.maxLines - 1 && more) {
+        layout->truncated = true;
+        if (style.ellipsis) {
+          float limit = maxWidth > 0.0f ? maxWidth : FLT_MAX;
+          while (lineEnd > lineStart &&
+                 prefix[lineEnd] - prefix[lineStart] + ellipsisWidth > limit)
+            lineEnd--;
+          while (lineEnd > lineStart && codepoints[lineEnd - 1] == ' ')
+            lineEnd--;
+        }
+        addLine(lineStart, lineEnd, style.ellipsis);
+        paragraphEnd = count;
+        break;
+      }
+      addLine(lineStart, lineEnd, false);
+      lineStart = next;
+    } while (lineStart < paragraphEnd);
+
+    if (paragraphEnd >= count)
+      break;
+    start = paragraphEnd + 1;
+  }
+
+  float boxWidth = maxWidth > 0.0f ? maxWidth : layout->size.x;
+  for (TextLayoutLine &line : layout->lines) {
+    switch (style.alignment) {
+    case TextAlignment::Left:
+      line.x = 0.0f;
+      break;
+    case TextAlignment::Center:
+      line.x = (boxWidth - line.width) / 2.0f;
+      break;
+    case TextAlignment::Right:
+      line.x = boxWidth - line.width;
+      break;
+    }
+  }
+  layout->size.y = layout->lines.size() * layout->lineHeight;
+}
+
+const TextLayoutResult &TextLayout::Get(const char *text,
+                                        const TextLayoutStyle &style,
+                                        uint64_t textHash) {
+  if (!text)
+    text = "";
+  Font font = Theme::GetFont(style.fontSize, style.weight);
+  if (!enabled_ || !font.glyphs) {
+    FontManager::EnsureGlyphs(font, text);
+    if (style.ellipsis && style.maxLines > 0)
+      FontManager::EnsureGlyphs(font, kEllipsis);
+    Build(text, style, font, &scratch_);
+    return scratch_;
+  }
+
+  if (textHash == 0)
+    textHash = TextMeasureCache::Hash(text);
+  Key key = {FontManager::GetFontId(font),
+             textHash,
+             style.fontSize,
+             style.maxWidth,
+             style.lineHeight,
+             style.maxLines,
+             style.weight,
+             style.alignment,
+             style.ellipsis};
+  if (const TextLayoutResult *cached = cache_.Find(key))
+    return *cached;
+
+  FontManager::EnsureGlyphs(font, text);
+  if (style.ellipsis && style.maxLines > 0)
+    FontManager::EnsureGlyphs(font, kEllipsis);
+  // A stand-in font (glyphs still rasterizing) lays out only approximately.
+  if (FontManager::GetFontId(font) != key.font) {
+    Build(text, style, font, &scratch_);
+    return scratch_;
+  }
+
+  // A full cache hands back the evicted layout, whose line storage Build()
+  // reuses.
+  TextLayoutResult &layout = cache_.Insert(key, capacity_);
+  Build(text, style, font, &layout);
+  return layout;
+}
+
+Vector2 TextLayout::Measure(const char *text, const TextLayoutStyle &style,
+                            uint64_t textHash) {
+  return Get(text, style, textHash).size;
+}
+
+void TextLayout::Draw(const TextLayoutResult &layout, Vector2 position,
+                      Color color) {
+  float halfLeading = (layout.lineHeight - layout.fontSize) / 2.0f;
+  for (size_t i = 0; i < layout.lines.size(); i++) {
+    const TextLayoutLine &line = layout.lines[i];
+    Vector2 linePos = {position.x + line.x,
+                       position.y + i * layout.lineHeight + halfLeading};
+    Renderer::DrawText(line.text.c_str(), linePos, layout.fontSize, color,
+                       layout.weight);
+  }
+}
+
+void TextLayout::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+  if (!enabled)
+    Clear();
+}
+
+void TextLayout::SetCapacity(int maxEntries) {
+  capacity_ = maxEntries < 1 ? 1 : maxEntries;
+  cache_.Trim(capacity_);
+}
+
+void TextLayout::Clear() { cache_.Clear(); }
+
+} // namespace raym3
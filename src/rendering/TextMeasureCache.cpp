@@ -0,0 +1,62 @@
+#include "raym3/rendering/TextMeasureCache.h"
+#include "raym3/rendering/PerfCounters.h"
+
+namespace raym3 {
+
+bool TextMeasureCache::enabled_ = true;
+int TextMeasureCache::capacity_ = 4096;
+LruCache<TextMeasureCache::Key, Vector2, TextMeasureCache::KeyHash>
+    TextMeasureCache::cache_;
+
+std::size_t TextMeasureCache::KeyHash::operator()(const Key &key) const {
+  uint64_t h = key.text;
+  HashCombine(h, key.font);
+  HashCombine(h, FloatBits(key.fontSize) << 32 | FloatBits(key.spacing));
+  return (std::size_t)h;
+}
+
+void TextMeasureCache::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+  if (!enabled)
+    Clear();
+}
+
+void TextMeasureCache::SetCapacity(int maxEntries) {
+  capacity_ = maxEntries < 1 ? 1 : maxEntries;
+  cache_.Trim(capacity_);
+}
+
+uint64_t TextMeasureCache::Hash(const char *text) {
+  // 64-bit FNV-1a.
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+    h ^= *p;
+    h *= 0x100000001b3ull;
+  }
+  return h ? h : 1;
+}
+
+bool TextMeasureCache::Lookup(uint64_t fontId, uint64_t textHash,
+                              float fontSize, float spacing, Vector2 *size) {
+  const Vector2 *cached = cache_.Find({fontId, textHash, fontSize, spacing});
+  if (!cached) {
+    PerfCounters::Frame().textCacheMisses++;
+    return false;
+  }
+  PerfCounters::Frame().textCacheHits++;
+  *size = *cached;
+  return true;
+}
+
+void TextMeasureCache::Store(uint64_t fontId, uint64_t textHash,
+                             float fontSize, float spacing, Vector2 size) {
+  Key key = {fontId, textHash, fontSize, spacing};
+  if (Vector2 *cached = cache_.Touch(key))
+    *cached = size;
+  else
+    cache_.Insert(key, capacity_) = size;
+}
+
+void TextMeasureCache::Clear() { cache_.Clear(); }
+
+} // namespace raym3
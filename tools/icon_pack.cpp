@@ -0,0 +1,80 @@
+// Builds an IconPack from a resources/icons tree:
+//
+//   raym3_icon_pack <icons dir> <output .rm3i>
+//
+// Every <variation>/<name>.svg is parsed with nanosvg and stored as encoded
+// shapes, or as its SVG text if the encoding cannot represent it.
+
+#include "raym3/rendering/IconPack.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "external/nanosvg.h"
+
+using namespace raym3;
+
+// In IconVariation order.
+static const char *kVariationFolders[] = {"filled", "outlined", "round",
+                                          "sharp", "two-tone"};
+
+int main(int argc, char **argv) {
+  if (argc != 3) {
+    fprintf(stderr, "usage: %s <icons dir> <output .rm3i>\n", argv[0]);
+    return 2;
+  }
+  std::filesystem::path root = argv[1];
+
+  std::vector<IconPackEntry> entries;
+  size_t svgBytes = 0;
+  int fallbacks = 0;
+  int failures = 0;
+  for (int v = 0; v < 5; v++) {
+    std::filesystem::path folder = root / kVariationFolders[v];
+    std::error_code error;
+    if (!std::filesystem::is_directory(folder, error))
+      continue;
+    for (const auto &file : std::filesystem::directory_iterator(folder)) {
+      if (file.path().extension() != ".svg")
+        continue;
+      std::ifstream in(file.path(), std::ios::binary);
+      std::string text((std::istreambuf_iterator<char>(in)),
+                       std::istreambuf_iterator<char>());
+      svgBytes += text.size();
+
+      IconPackEntry entry = {v, file.path().stem().string(), {}, false};
+      // nsvgParse writes into its input.
+      std::string scratch = text;
+      NSVGimage *image = nsvgParse(scratch.data(), "px", 96.0f);
+      if (!image) {
+        fprintf(stderr, "skipping %s: parse failed\n",
+                file.path().string().c_str());
+        failures++;
+        continue;
+      }
+      if (!IconPack::Encode(image, &entry.data)) {
+        entry.data.assign(text.begin(), text.end());
+        entry.svg = true;
+        fallbacks++;
+      }
+      nsvgDelete(image);
+      entries.push_back(std::move(entry));
+    }
+  }
+
+  size_t count = entries.size();
+  if (!IconPack::Write(argv[2], std::move(entries))) {
+    fprintf(stderr, "failed to write %s\n", argv[2]);
+    return 1;
+  }
+  std::error_code error;
+  uintmax_t packBytes = std::filesystem::file_size(argv[2], error);
+  printf("%zu icons (%d as SVG text, %d skipped): %zu bytes of SVG -> %llu "
+         "byte pack\n",
+         count, fallbacks, failures, svgBytes, (unsigned long long)packBytes);
+  return 0;
+}